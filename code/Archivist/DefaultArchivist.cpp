@@ -10,6 +10,8 @@
 
 #include "DefaultArchivist.h"
 
+#include <Utilities/ThreadPool.h>
+
 #include<limits>
 
 ////// ARCHIVIST-outputMethod is actually set by Modules.h //////
@@ -61,6 +63,13 @@ std::shared_ptr<ParameterLink<std::string>>
                                        "prefix for files saved by "
                                        "this archivst. \"NONE\" "
                                        "indicates no prefix.");
+std::shared_ptr<ParameterLink<std::string>>
+    DefaultArchivist::Arch_formatPL = Parameters::register_parameter(
+        "ARCHIVIST_DEFAULT-format", std::string("csv"),
+        "format of data files (pop, max, snapshot data and the data files "
+        "of other archivists): csv, or binary for columnar .mbin files "
+        "(smaller and faster to write, read them with tools/mbin.py). "
+        "organisms files are always csv");
 std::shared_ptr<ParameterLink<bool>>
     DefaultArchivist::SS_Arch_writeDataFilesPL = Parameters::register_parameter(
         "ARCHIVIST_DEFAULT-writeSnapshotDataFiles", false,
@@ -81,18 +90,31 @@ DefaultArchivist::DefaultArchivist(std::shared_ptr<ParametersTable> PT_,
   writePopFile = Arch_writePopFilePL->get(PT);
   writeMaxFile = Arch_writeMaxFilePL->get(PT);
 
+  if (Arch_formatPL->get(PT) == "csv") {
+    DataFileExtension = ".csv";
+  } else if (Arch_formatPL->get(PT) == "binary") {
+    DataFileExtension = ColumnarTable::extension;
+  } else {
+    std::cout << "  In DefaultArchivist :: ARCHIVIST_DEFAULT-format is \""
+              << Arch_formatPL->get(PT)
+              << "\", it must be csv or binary.\n  exiting" << std::endl;
+    exit(1);
+  }
+
   PopFileName =
       (group_prefix_.empty())
-          ? "pop.csv"
-          : group_prefix_.substr(0, group_prefix_.size() - 2) + "__pop.csv";
+          ? "pop" + DataFileExtension
+          : group_prefix_.substr(0, group_prefix_.size() - 2) + "__pop" +
+                DataFileExtension;
   PopFileName = (Arch_FilePrefixPL->get(PT) == "NONE")
                     ? PopFileName
                     : Arch_FilePrefixPL->get(PT) + PopFileName;
 
   MaxFileName =
       (group_prefix_.empty())
-          ? "max.csv"
-          : group_prefix_.substr(0, group_prefix_.size() - 2) + "__max.csv";
+          ? "max" + DataFileExtension
+          : group_prefix_.substr(0, group_prefix_.size() - 2) + "__max" +
+                DataFileExtension;
   MaxFileName = (Arch_FilePrefixPL->get(PT) == "NONE")
                     ? MaxFileName
                     : Arch_FilePrefixPL->get(PT) + MaxFileName;
@@ -174,6 +196,9 @@ DefaultArchivist::DefaultArchivist(std::vector<std::string> & popFileColumns,
     else // add key normally, because it has no special flags specified
       unique_column_name_to_output_behaviors_[key] |= DataMap::AVE;
   }
+  for (auto &kv : unique_column_name_to_output_behaviors_)
+    if (kv.first != "update")
+      pop_file_keys_.emplace_back(kv.first);
 }
 
 // save Max and pop file data
@@ -184,18 +209,57 @@ void DefaultArchivist::writeRealTimeFiles(
   // write out population data
 
   if (writePopFile) {
+    population_stats_.fill(population, pop_file_keys_, [&](const Organism &org) {
+      return org.timeOfBirth < Global::update || save_new_orgs_;
+    });
+    // PopMap holds the finished values, one column each (as FIRST), named as
+    // the file's columns are and given in the order DataMap would write them
     DataMap PopMap;
+    std::vector<std::string> columns;
+    auto addColumn = [&](const std::string &name, double value) {
+      PopMap.set(name, value);
+      columns.push_back(name);
+    };
+    PopMap.set("update", Global::update); // always written, in name order
+    bool updateAdded = false;
+    size_t c = 0;
     for (auto &kv : unique_column_name_to_output_behaviors_) {
-      if (kv.first != "update")
-        for (auto const &org : population)
-          if (org->timeOfBirth < Global::update || save_new_orgs_)
-            PopMap.append(kv.first, org->dataMap.getAverage(kv.first));
-
-      PopMap.setOutputBehavior(kv.first, kv.second);
+      auto OB = kv.second;
+      if (!updateAdded && kv.first >= "update") {
+        columns.push_back("update");
+        updateAdded = true;
+      }
+      if (kv.first == "update")
+        continue;
+      if (OB & DataMap::LIST) { // the whole column is written, DataMap does it all
+        PopMap.set(kv.first, population_stats_.columnValues(c));
+        PopMap.setOutputBehavior(kv.first, OB);
+        columns.push_back(kv.first);
+      } else {
+        if (OB & DataMap::FIRST)
+          addColumn(kv.first, population_stats_.first(c));
+        if (OB & DataMap::AVE)
+          addColumn(kv.first + "_AVE", population_stats_.mean(c));
+        if (OB & DataMap::VAR)
+          addColumn(kv.first + "_VAR", population_stats_.variance(c));
+        if (OB & DataMap::SUM)
+          addColumn(kv.first + "_SUM", population_stats_.sum(c));
+        if (OB & DataMap::MIN)
+          addColumn(kv.first + "_MIN", population_stats_.min(c));
+        if (OB & DataMap::MAX)
+          addColumn(kv.first + "_MAX", population_stats_.max(c));
+        if (OB & DataMap::PROD) // as DataMap would warn
+          std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
+                    << std::endl;
+        if (OB & DataMap::STDERR)
+          std::cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!"
+                    << std::endl;
+      }
+      c++;
     }
-    PopMap.set("update", Global::update);
-    PopMap.writeToFile(
-        PopFileName, {}); // write the PopMap to file with empty list (save all)
+    if (!updateAdded)
+      columns.push_back("update");
+    writeToFile(std::move(PopMap), PopFileName, columns);
   }
 
   // write out Max data
@@ -219,7 +283,7 @@ void DefaultArchivist::writeRealTimeFiles(
       exit(1);
     }
     best_org->dataMap.set("update", Global::update);
-    best_org->dataMap.writeToFile(MaxFileName);
+    writeToFile(best_org->dataMap, MaxFileName);
     best_org->dataMap.clear("update");
   }
 }
@@ -229,7 +293,7 @@ void DefaultArchivist::saveSnapshotData(
 
   	// write out data
   std::string dataFileName =
-      DataFilePrefix + "_" + std::to_string(Global::update) + ".csv";
+      DataFilePrefix + "_" + std::to_string(Global::update) + DataFileExtension;
 
   if (files_.find("snapshotData") ==
       files_.end()) { // first make sure that the dataFile has been set up.
@@ -260,8 +324,8 @@ void DefaultArchivist::saveSnapshotData(
 		saveOrgToFile(org,dataFileName);
   }
 
-  FileManager::closeFile(dataFileName); // since this is a snapshot, we will not
-                                        // be writting to this file again.
+  closeFile(dataFileName); // since this is a snapshot, we will not be
+                           // writting to this file again.
 }
 
 void DefaultArchivist::saveOrgToFile(const std::shared_ptr<Organism> &org, const std::string &data_file_name) {
@@ -277,7 +341,7 @@ void DefaultArchivist::saveOrgToFile(const std::shared_ptr<Organism> &org, const
 
   org->dataMap.set("update", Global::update);
   org->dataMap.setOutputBehavior("update", DataMap::FIRST);
-  org->dataMap.writeToFile(data_file_name, files_["snapshotData"]); // append new data to the file
+  writeToFile(org->dataMap, data_file_name, files_["snapshotData"]); // append new data to the file
   org->dataMap.clear("snapshotAncestors");
   org->dataMap.clear("update");
 }
@@ -368,12 +432,44 @@ void DefaultArchivist::saveSnapshotOrganisms(
         tempName = "BRAIN_" + brain.first;
         OrgMap.merge(brain.second->serialize(tempName));
       }
-      OrgMap.writeToFile(organismFileName); // append new data to the file
+      writeToFile(std::move(OrgMap), organismFileName); // append new data to the file
     }
   }
-  FileManager::closeFile(organismFileName); // since this is a snapshot, we will
-                                            // not be writting to this file
-                                            // again.
+  closeFile(organismFileName); // since this is a snapshot, we will not be
+                               // writting to this file again.
+}
+
+void DefaultArchivist::writeToFile(DataMap &dataMap,
+                                   const std::string &fileName,
+                                   const std::vector<std::string> &keys) {
+  if (Global::pipelineArchivePL->get()) {
+    getArchiveQueue().push([dataMap, fileName, keys]() mutable {
+      dataMap.writeToFile(fileName, keys);
+    });
+  } else {
+    dataMap.writeToFile(fileName, keys);
+  }
+}
+
+void DefaultArchivist::writeToFile(DataMap &&dataMap,
+                                   const std::string &fileName,
+                                   const std::vector<std::string> &keys) {
+  if (Global::pipelineArchivePL->get()) {
+    getArchiveQueue().push(
+        [dataMap = std::move(dataMap), fileName, keys]() mutable {
+          dataMap.writeToFile(fileName, keys);
+        });
+  } else {
+    dataMap.writeToFile(fileName, keys);
+  }
+}
+
+void DefaultArchivist::closeFile(const std::string &fileName) {
+  if (Global::pipelineArchivePL->get()) {
+    getArchiveQueue().push([fileName] { FileManager::closeFile(fileName); });
+  } else {
+    FileManager::closeFile(fileName);
+  }
 }
 
 void DefaultArchivist::writeDefArchFiles(
@@ -476,5 +572,29 @@ void DefaultArchivist::cleanUpParents(
   */
 }
 
+void DefaultArchivist::saveCheckpoint(CheckpointWriter &out) {
+  out.section("DefaultArchivist");
+  out.put(realtime_sequence_index_);
+  out.put(realtime_data_seq_index_);
+  out.put(realtime_organism_seq_index_);
+  out.put(finished_);
+  out.put(static_cast<uint64_t>(files_.size()));
+  for (auto &file : files_) {
+    out.put(file.first);
+    out.put(file.second);
+  }
+}
 
-
+void DefaultArchivist::loadCheckpoint(CheckpointReader &in) {
+  in.section("DefaultArchivist");
+  in.get(realtime_sequence_index_);
+  in.get(realtime_data_seq_index_);
+  in.get(realtime_organism_seq_index_);
+  in.get(finished_);
+  files_.clear();
+  auto count = in.get<uint64_t>();
+  for (uint64_t i = 0; i < count; i++) {
+    auto name = in.get<std::string>();
+    in.get(files_[name]);
+  }
+}
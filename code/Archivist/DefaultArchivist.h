@@ -19,6 +19,7 @@
 
 #include "../Global.h"
 #include "../Organism/Organism.h"
+#include "PopulationStats.h"
 #include "../Utilities/MTree.h"
 
 class DefaultArchivist {
@@ -35,6 +36,7 @@ public:
   std::string PopFileColumnNames; // data to be saved into average file (must be
                                   // values that can generate an average)
 
+  std::string DataFileExtension;  // ".csv" or ".mbin" (see Arch_formatPL)
   std::string DataFilePrefix;     // name of the Data file
   std::string OrganismFilePrefix; // name of the Genome file (genomes on LOD)
   bool writeSnapshotDataFiles;    // if true, write data file
@@ -62,6 +64,8 @@ public:
                                                       // PopFile
 
   std::map<std::string, int> unique_column_name_to_output_behaviors_;
+  std::vector<DataMap::Key> pop_file_keys_; // the above, without "update"
+  PopulationStats population_stats_; // pop file values, see writeRealTimeFiles
 
   bool finished_ =
       false; // if finished, then as far as the archivist is concerned, we
@@ -88,6 +92,19 @@ public:
 
   void cleanUpParents(std::vector<std::shared_ptr<Organism>> & /*population*/);
 
+  // write dataMap to fileName (see DataMap::writeToFile). If
+  // GLOBAL-pipelineArchive is set, a copy of dataMap is written later on the
+  // archive thread, so dataMap may be changed as soon as this returns.
+  static void writeToFile(DataMap & /*dataMap*/,
+                          const std::string & /*fileName*/,
+                          const std::vector<std::string> & /*keys*/ = {});
+  // as above, for a dataMap that is not needed after (it is not copied)
+  static void writeToFile(DataMap && /*dataMap*/,
+                          const std::string & /*fileName*/,
+                          const std::vector<std::string> & /*keys*/ = {});
+  // close fileName once everything written with writeToFile is in the file
+  static void closeFile(const std::string & /*fileName*/);
+
   //void resolveAncestors(const std::shared_ptr<Organism> &/*org*/,
   //                      std::vector<std::shared_ptr<Organism>> & /*save_file*/,
   //                      int /*min_birth_time*/);
@@ -113,6 +130,8 @@ public:
 
   static std::shared_ptr<ParameterLink<std::string>>
       Arch_FilePrefixPL; // name of the Data file
+  static std::shared_ptr<ParameterLink<std::string>>
+      Arch_formatPL; // csv or binary data files
   static std::shared_ptr<ParameterLink<bool>>
       SS_Arch_writeDataFilesPL; // if true, write data file
   static std::shared_ptr<ParameterLink<bool>>
@@ -130,4 +149,10 @@ public:
   // return true if next save will be > updates + terminate after
   virtual bool archive(std::vector<std::shared_ptr<Organism>> & /*population*/,
                        int /*flush*/ = 0);
+
+  // write/read where this archivist is in its sequences (for
+  // GLOBAL-checkpointInterval). archivists that keep organisms beyond the
+  // current population (lines of descent) cannot be checkpointed.
+  virtual void saveCheckpoint(CheckpointWriter & /*out*/);
+  virtual void loadCheckpoint(CheckpointReader & /*in*/);
 };
@@ -60,9 +60,9 @@ LODwAPArchivist::LODwAPArchivist(std::vector<std::string> popFileColumns,
                       ? ""
                       : LODwAP_Arch_FilePrefixPL->get(PT)) +
                  (group_prefix_.empty()
-                       ? "LOD_data.csv"
+                       ? "LOD_data" + DataFileExtension
                        : group_prefix_.substr(0, group_prefix_.size() - 2) +
-                             "__" + "LOD_data.csv");
+                             "__" + "LOD_data" + DataFileExtension);
   organism_file_name_ = (LODwAP_Arch_FilePrefixPL->get(PT) == "NONE"
                           ? ""
                           : LODwAP_Arch_FilePrefixPL->get(PT)) +
@@ -124,9 +124,8 @@ void LODwAPArchivist::writeLODDataFile(
         std::max(0, current->timeOfBirth - real_MRCA->timeOfBirth);
     current->dataMap.set("timeToCoalescence", time_to_coalescence);
     current->dataMap.setOutputBehavior("timeToCoalescence", DataMap::FIRST);
-    current->dataMap.writeToFile(
-        data_file_name_,
-        files_[data_file_name_]); // append new data to the file
+    writeToFile(current->dataMap, data_file_name_,
+                files_[data_file_name_]); // append new data to the file
     current->dataMap.clear("update");
     current->dataMap.clear("timeToCoalescence");
 
@@ -171,7 +170,7 @@ void LODwAPArchivist::writeLODOrganismFile(
       auto name = "BRAIN_" + brain.first;
       OrgMap.merge(brain.second->serialize(name));
     }
-    OrgMap.writeToFile(organism_file_name_); // append new data to the file
+    writeToFile(std::move(OrgMap), organism_file_name_); // append new data to the file
 
     next_organism_write_ = organismSequence[++organism_seq_index];
   }
@@ -302,3 +301,16 @@ bool LODwAPArchivist::archive(std::vector<std::shared_ptr<Organism>> &population
 
 }
 
+void LODwAPArchivist::saveCheckpoint(CheckpointWriter &out) {
+  std::cout << "  In LODwAPArchivist :: checkpoints (GLOBAL-checkpointInterval) "
+               "only work with the Default archivist.\n  exiting"
+            << std::endl;
+  exit(1);
+}
+
+void LODwAPArchivist::loadCheckpoint(CheckpointReader &in) {
+  std::cout << "  In LODwAPArchivist :: can not restart from a checkpoint, "
+               "checkpoints only work with the Default archivist.\n  exiting"
+            << std::endl;
+  exit(1);
+}
@@ -59,6 +59,10 @@ public:
 
   virtual bool archive(std::vector<std::shared_ptr<Organism>> &population,
                        int flush = 0) override;
+
+  // not supported, the saved ancestors are not part of a checkpoint
+  virtual void saveCheckpoint(CheckpointWriter &out) override;
+  virtual void loadCheckpoint(CheckpointReader &in) override;
  
  
   std::string data_file_name_;          // name of the Data file
@@ -0,0 +1,79 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "PopulationStats.h"
+
+#include <algorithm>
+
+void PopulationStats::fill(
+    const std::vector<std::shared_ptr<Organism>> &population,
+    const std::vector<DataMap::Key> &keys,
+    const std::function<bool(const Organism &)> &keep) {
+  kept.clear();
+  for (auto const &org : population) {
+    if (keep(*org)) {
+      kept.push_back(org.get());
+    }
+  }
+  rowCount = kept.size();
+  columnCount = keys.size();
+  values.resize(rowCount * columnCount);
+  auto value = values.begin();
+  for (auto const &key : keys) {
+    for (auto org : kept) {
+      *value++ = org->dataMap.getAverage(key);
+    }
+  }
+}
+
+double PopulationStats::first(size_t c) const {
+  return rowCount ? column(c)[0] : 0;
+}
+
+// the sums are in row order, as DataMap's are, so results match to the bit
+double PopulationStats::mean(size_t c) const {
+  auto average = sum(c);
+  if (rowCount > 1) {
+    average /= rowCount;
+  }
+  return average;
+}
+
+double PopulationStats::variance(size_t c) const {
+  auto values = column(c);
+  double average = sum(c) / rowCount;
+  double variance = 0;
+  for (size_t r = 0; r < rowCount; r++) {
+    variance += (values[r] - average) * (values[r] - average);
+  }
+  if (rowCount > 0) {
+    variance /= rowCount - 1;
+  } else {
+    variance = 0;
+  }
+  return variance;
+}
+
+double PopulationStats::sum(size_t c) const {
+  auto values = column(c);
+  double total = 0;
+  for (size_t r = 0; r < rowCount; r++) {
+    total += values[r];
+  }
+  return total;
+}
+
+double PopulationStats::min(size_t c) const {
+  return rowCount ? *std::min_element(column(c), column(c) + rowCount) : 0;
+}
+
+double PopulationStats::max(size_t c) const {
+  return rowCount ? *std::max_element(column(c), column(c) + rowCount) : 0;
+}
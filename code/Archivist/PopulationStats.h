@@ -0,0 +1,52 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../Organism/Organism.h"
+
+// The values of the pop file columns for every organism, stored a column at
+// a time (one contiguous run of doubles per key). The pop file aggregates
+// are then each one pass over a dense array, rather than lookups in every
+// organism's dataMap. The reductions give the same results as DataMap's
+// getAverage, getVariance, getSum, getMin and getMax would on the column.
+class PopulationStats {
+public:
+  // one row for each organism in population that keep is true for, holding
+  // org->dataMap.getAverage(key) for each of keys
+  void fill(const std::vector<std::shared_ptr<Organism>> &population,
+            const std::vector<DataMap::Key> &keys,
+            const std::function<bool(const Organism &)> &keep);
+
+  size_t rows() const { return rowCount; }
+  size_t columns() const { return columnCount; }
+
+  const double *column(size_t c) const { return values.data() + c * rowCount; }
+  std::vector<double> columnValues(size_t c) const {
+    return std::vector<double>(column(c), column(c) + rowCount);
+  }
+
+  double first(size_t c) const; // 0 if there are no rows
+  double mean(size_t c) const;
+  double variance(size_t c) const;
+  double sum(size_t c) const;
+  double min(size_t c) const;
+  double max(size_t c) const;
+
+private:
+  std::vector<double> values; // column c is values[c * rowCount ...]
+  size_t rowCount = 0;
+  size_t columnCount = 0;
+  std::vector<Organism *> kept; // reused between fills
+};
@@ -431,7 +431,7 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
             tempName = "BRAIN_" + brain.first;
             OrgMap.merge(brain.second->serialize(tempName));
           }
-          OrgMap.writeToFile(organismFileName); // append new data to the file
+          writeToFile(std::move(OrgMap), organismFileName); // append new data to the file
           index++;
         } else { // this ptr is expired - cut it out of the vector
           swap(checkpoints[nextOrganismWrite][index],
@@ -442,9 +442,8 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
         }
       }
 
-      FileManager::closeFile(organismFileName); // since this is a snapshot, we
-                                                // will not be writting to this
-                                                // file again.
+      closeFile(organismFileName); // since this is a snapshot, we will not be
+                                   // writting to this file again.
 
       if ((int)organismSequence.size() > writeOrganismSeqIndex + 1) {
         writeOrganismSeqIndex++;
@@ -462,7 +461,8 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
         writeDataFiles) { // now it's time to write data in the checkpoint at
                           // time nextDataWrite
       std::string dataFileName =
-          DataFilePrefix + "_" + std::to_string(nextDataWrite) + ".csv";
+          DataFilePrefix + "_" + std::to_string(nextDataWrite) +
+          DataFileExtension;
 
       // if file info has not been initialized yet, find a valid org and extract
       // it's keys
@@ -511,8 +511,8 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
           org->snapShotDataMaps[nextDataWrite].set("update", nextDataWrite);
           org->snapShotDataMaps[nextDataWrite].setOutputBehavior(
               "update", DataMap::FIRST);
-          org->snapShotDataMaps[nextDataWrite].writeToFile(
-              dataFileName, files_["data"]); // append new data to the file
+          writeToFile(org->snapShotDataMaps[nextDataWrite], dataFileName,
+                      files_["data"]); // append new data to the file
           index++;                           // advance to nex element
         } else { // this ptr is expired - cut it out of the vector
           swap(checkpoints[nextDataWrite][index],
@@ -607,3 +607,16 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
   return finished_;
 }
 
+void SSwDArchivist::saveCheckpoint(CheckpointWriter &out) {
+  std::cout << "  In SSwDArchivist :: checkpoints (GLOBAL-checkpointInterval) "
+               "only work with the Default archivist.\n  exiting"
+            << std::endl;
+  exit(1);
+}
+
+void SSwDArchivist::loadCheckpoint(CheckpointReader &in) {
+  std::cout << "  In SSwDArchivist :: can not restart from a checkpoint, "
+               "checkpoints only work with the Default archivist.\n  exiting"
+            << std::endl;
+  exit(1);
+}
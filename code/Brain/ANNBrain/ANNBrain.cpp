@@ -31,7 +31,8 @@ std::shared_ptr<ParameterLink<std::string>> ANNBrain::thresholdMethodPL = Parame
 
 // The weight matrix
 // weights defines how every node will contribute to each node in the next layer
-// The weight matrix is organized as [layers[nodes[next_layer_node]]]. So weights[2][4][7] would define contribution
+// Each layer of weights is one contiguous row-major matrix with a row for each node in the layer and a column
+//   for each node in the next layer. So weights[2][4 * nodes[3].size() + 7] would define contribution
 //   of the fourth node in the second layer to the seventh node in the third layer.
 
 ANNBrain::ANNBrain(int _nrInNodes, int _nrOutNodes, std::shared_ptr<ParametersTable> _PT) : AbstractBrain(_nrInNodes, _nrOutNodes, _PT) {
@@ -103,22 +104,12 @@ std::shared_ptr<AbstractBrain> ANNBrain::makeBrain(std::unordered_map<std::strin
 
 	// set up wights
  	newBrain->weights.resize((int)newBrain->nodes.size()-1); // first dim of weights is numlayers-1 (not the output/recurrent layer)
-	for(int i=0;i<(int)newBrain->weights.size();i++) {
-        // for each weight layer (numlayers-1) resize to (ins+recurrent) or (outs+recurrent)
-        newBrain->weights[i].resize((int)newBrain->nodes[i].size());
-        // this is where we create the weight matrix (each node from the previous layer has a weight for each node in the next layer
-        for(int j=0;j<(int)newBrain->weights[i].size();j++) {
-            // resize weights to same size as next layer
-            newBrain->weights[i][j].resize((int)newBrain->nodes[i+1].size());
-        }
-    }
 	for (int i = 0; i < (int)newBrain->weights.size(); i++) { // for each weights layer
-		for (int j = 0; j < (int)newBrain->weights[i].size(); j++) { // for each weight set (i.e. the output weights for each node) in that layer
-			for (int k = 0; k < (int)newBrain->weights[i][j].size(); k++) { // for each weight (i.e. for each node in the next layer)
-				//double value=doCPPN(x,y,weightsCPPN);
-				double value = genomeHandler->readDouble(weightRange[0], weightRange[1]); // get a value in range [-1.0,1.0) from genome
-				newBrain->weights[i][j][k] = value; // create a 'normal' distribution
-			}
+		// each node from the previous layer has a weight for each node in the next layer
+		newBrain->weights[i].resize(newBrain->nodes[i].size() * newBrain->nodes[i + 1].size());
+		for (auto &w : newBrain->weights[i]) { // row by row (i.e. the output weights for each node)
+			//double value=doCPPN(x,y,weightsCPPN);
+			w = genomeHandler->readDouble(weightRange[0], weightRange[1]); // get a value in range [-1.0,1.0) from genome
 		}
 	}
 
@@ -165,13 +156,19 @@ void ANNBrain::update() {
     // starting with second layer, compute forward activations
     for(int layer=1;layer<(int)nodes.size();layer++) {
         // reset summation for current layer
-		for (int i = 0; i < (int)nodes[layer].size(); i++) {
-			nodes[layer][i] = biases[layer - 1][i]; // indexing from 1, and biases starts at layer 1 (hence the - 1)
-		}
+		nodes[layer] = biases[layer - 1]; // indexing from 1, and biases starts at layer 1 (hence the - 1)
         // sum activations for current layer assuming well-connected to previous layer
-        for(int i=0;i<(int)nodes[layer-1].size();i++) { // for each node in the previous layer
-            for(int j=0;j<(int)nodes[layer].size();j++) { // for each output weight associated with that node
-                nodes[layer][j] += weights[layer-1][i][j]*nodes[layer-1][i]; // add the nodes weighted value to each node in this layer
+		// (inner loop runs over one contiguous row of weights, so the compiler can vectorize it)
+		const int nrIn = (int)nodes[layer - 1].size();
+		const int nrOut = (int)nodes[layer].size();
+		const double *in = nodes[layer - 1].data();
+		const double *w = weights[layer - 1].data();
+		double *out = nodes[layer].data();
+        for(int i=0;i<nrIn;i++) { // for each node in the previous layer
+			const double value = in[i];
+			const double *row = w + i * nrOut;
+            for(int j=0;j<nrOut;j++) { // for each output weight associated with that node
+                out[j] += row[j]*value; // add the nodes weighted value to each node in this layer
             }
         }
 		switch (thresholdMethod) {
@@ -262,10 +259,11 @@ void ANNBrain::showBrain(){
     }
 	for (int i = 0; i < (int)weights.size(); i++) {
 		printf("layer(%d)\n", i);
-		for (int j = 0; j < (int)weights[i].size(); j++) {
+		int nrOut = (int)nodes[i + 1].size();
+		for (int j = 0; j < (int)nodes[i].size(); j++) {
 			printf("  node(%d) weights [", j);
-			for (int k = 0; k < (int)weights[i][j].size(); k++) {
-				printf("  %f,", weights[i][j][k]);
+			for (int k = 0; k < nrOut; k++) {
+				printf("  %f,", weights[i][j * nrOut + k]);
 			}
 			printf("]\n");
 		}
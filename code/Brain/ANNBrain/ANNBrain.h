@@ -49,7 +49,9 @@ public:
 
     int _I,_O;
 	std::vector<std::vector<double>> nodes, biases;
-	std::vector<std::vector<std::vector<double>>> weights;
+	// one row-major matrix per layer, weights[layer][i * nodes[layer + 1].size() + j]
+	// is the weight from node i in layer to node j in layer + 1
+	std::vector<std::vector<double>> weights;
 	ANNBrain() = delete;
 
 	ANNBrain(int _nrInNodes, int _nrOutNodes, std::shared_ptr<ParametersTable> _PT = Parameters::root);
@@ -10,6 +10,8 @@
 
 #include "AbstractBrain.h"
 
+#include <algorithm>
+
 ////// BRAIN-brainType is actually set by Modules.h //////
 std::shared_ptr<ParameterLink<std::string>> AbstractBrain::brainTypeStrPL =
     Parameters::register_parameter(
@@ -18,9 +20,21 @@ std::shared_ptr<ParameterLink<std::string>> AbstractBrain::brainTypeStrPL =
                                             // outputMethod;
 ////// BRAIN-brainType is actually set by Modules.h //////
 
+std::shared_ptr<ParameterLink<int>> AbstractBrain::updateCacheSizePL =
+    Parameters::register_parameter(
+        "BRAIN-updateCacheSize", 0,
+        "brains with deterministic updates (e.g. Markov brains with only "
+        "deterministic gates) remember this many update results per brain and "
+        "reuse them when the same inputs and state come up again. 0 = off");
+std::shared_ptr<ParameterLink<int>> AbstractBrain::updateCacheThresholdPL =
+    Parameters::register_parameter(
+        "BRAIN-updateCacheThreshold", 1,
+        "a cached update result is only reused after it has been computed this "
+        "many times");
 
 AbstractBrain::AbstractBrain(int ins, int outs, std::shared_ptr<ParametersTable> PT_)
-    : PT(PT_) {
+    : PT(PT_),
+      updateCache(updateCacheSizePL->get(PT_), updateCacheThresholdPL->get(PT_)) {
     nrInputValues = ins;
     nrOutputValues = outs;
     recordActivity = false;
@@ -44,6 +58,17 @@ std::shared_ptr<AbstractBrain> AbstractBrain::makeBrain(std::unordered_map<std::
     exit(1);
 }
 
+DataMap AbstractBrain::getUpdateCacheStats(std::string& prefix) {
+    DataMap dataMap;
+    if (updateCache.enabled()) {
+        dataMap.set(prefix + "updateCacheHits", updateCache.hits);
+        dataMap.set(prefix + "updateCacheMisses", updateCache.misses);
+        updateCache.hits = 0;
+        updateCache.misses = 0;
+    }
+    return dataMap;
+}
+
 std::string AbstractBrain::description() {
     // returns a desription of this brain in it's current state
     return "no description provided...";
@@ -130,6 +155,26 @@ void AbstractBrain::resetBrain() {
     resetOutputs();
 }
 
+void AbstractBrain::updateBatch(const std::vector<std::vector<double>>& inputs,
+                                std::vector<std::vector<double>>& outputs,
+                                int updates) {
+    outputs.resize(inputs.size());
+    for (size_t lane = 0; lane < inputs.size(); lane++) {
+        resetBrain();
+        int nrInputs = std::min(static_cast<int>(inputs[lane].size()), nrInputValues);
+        for (int i = 0; i < nrInputs; i++) {
+            setInput(i, inputs[lane][i]);
+        }
+        for (int u = 0; u < updates; u++) {
+            update();
+        }
+        outputs[lane].resize(nrOutputValues);
+        for (int i = 0; i < nrOutputValues; i++) {
+            outputs[lane][i] = readOutput(i);
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // these functions need to be filled in if genomes are being used in this brain
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -198,3 +243,23 @@ void AbstractBrain::deserialize(std::shared_ptr<ParametersTable> PT,
     // the corisponding serialize process
 }
 
+void AbstractBrain::saveCheckpoint(CheckpointWriter & out, std::string & name) {
+    auto brainData = serialize(name);
+    auto keys = brainData.getKeys();
+    out.put(static_cast<uint64_t>(keys.size()));
+    for (auto const & key : keys) {
+        out.put(key);
+        out.put(brainData.getStringOfVector(key));
+    }
+}
+
+void AbstractBrain::loadCheckpoint(CheckpointReader & in, std::string & name) {
+    std::unordered_map<std::string, std::string> brainData;
+    auto keyCount = in.get<uint64_t>();
+    for (uint64_t i = 0; i < keyCount; i++) {
+        auto key = in.get<std::string>();
+        in.get(brainData[key]);
+    }
+    deserialize(PT, brainData, name);
+}
+
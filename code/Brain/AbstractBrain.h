@@ -17,9 +17,13 @@
 #include <Utilities/Parameters.h>
 #include <Global.h>
 
+#include "UpdateCache.h"
+
 class AbstractBrain {
 public:
     static std::shared_ptr<ParameterLink<std::string>> brainTypeStrPL;
+    static std::shared_ptr<ParameterLink<int>> updateCacheSizePL;
+    static std::shared_ptr<ParameterLink<int>> updateCacheThresholdPL;
 
     const std::shared_ptr<ParametersTable> PT;
 
@@ -33,6 +37,10 @@ public:
     std::vector<double> inputValues;
     std::vector<double> outputValues;
 
+    // memo of update() results, only used by brains that know their update is
+    // deterministic (see UpdateCache.h). off unless BRAIN-updateCacheSize > 0
+    UpdateCache updateCache;
+
     AbstractBrain() = delete;
 
     AbstractBrain(int ins, int outs, std::shared_ptr<ParametersTable> PT_);
@@ -51,6 +59,9 @@ public:
 
     virtual DataMap getStats(std::string& prefix); // return a vector of DataMap of stats from this brain
 
+    // hits and misses of updateCache since the last call (empty if the cache is off)
+    DataMap getUpdateCacheStats(std::string& prefix);
+
     virtual std::string getType(); // return the type of this brain
 
     virtual void setInput(const int& inputAddress, const double& value);
@@ -67,6 +78,16 @@ public:
 
     virtual void resetBrain();
 
+    // run the brain once for each entry in inputs (a "lane"): reset, set the
+    // lane's inputs (missing inputs are 0), update the given number of times
+    // and copy the outputs into outputs[lane]. the default runs lanes one after
+    // another, so random numbers are drawn in the same order as doing this by
+    // hand. brains may override this to run many lanes at once. the state of
+    // the brain afterwards is undefined.
+    virtual void updateBatch(const std::vector<std::vector<double>>& inputs,
+                             std::vector<std::vector<double>>& outputs,
+                             int updates = 1);
+
     // setRecordActivity and setRecordFileName provide a standard way to set up brain
     // activity recoding. How and when the brain records activity is up to the brain developer
     virtual void inline setRecordActivity(bool _recordActivity) {
@@ -118,4 +139,10 @@ public:
         std::unordered_map<std::string, std::string>& orgData,
         std::string& name);
 
+    // write/read what a brain made with makeBrain(genomes) would not have,
+    // for checkpoints (see GLOBAL-checkpointInterval). by default this is
+    // what serialize saves.
+    virtual void saveCheckpoint(CheckpointWriter& out, std::string& name);
+    virtual void loadCheckpoint(CheckpointReader& in, std::string& name);
+
 };
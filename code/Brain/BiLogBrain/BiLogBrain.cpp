@@ -439,19 +439,6 @@ BiLogBrain::BiLogBrain(int In, int Out, std::shared_ptr<ParametersTable> PT) :
 		mutOneGate = mutOneGatePL->get(PT);
 	}
 
-	if (mutOneBrain > 0 || mutOneGate > 0) {
-		//double totMut = std::min(1.0, mut_logic1 + mut_logic2 + mut_logic3 + mut_logic4 + mut_wires1 + mut_wires2);
-		double totMut = mut_logic1 + mut_logic2 + mut_logic3 + mut_logic4 + mut_wires1 + mut_wires2;
-		mut_logic1_ratio = mut_logic1 / totMut;
-		mut_logic2_ratio = mut_logic1_ratio + (mut_logic2 / totMut);
-		mut_logic3_ratio = mut_logic2_ratio + (mut_logic3 / totMut);
-		mut_logic4_ratio = mut_logic3_ratio + (mut_logic4 / totMut);
-		mut_wires1_ratio = mut_logic4_ratio + (mut_wires1 / totMut);
-		mut_wires2_ratio = mut_wires1_ratio + (mut_wires2 / totMut);
-		//std::cout << mut_logic1_ratio << "  " << mut_logic2_ratio << "  " << mut_logic3_ratio << "  "
-		//	<< mut_logic4_ratio << "  " << mut_wires1_ratio << "  " << mut_wires2_ratio << std::endl;
-	}
-
 	recordMutationHistory = recordMutationHistoryPL->get(PT);
 
 	popFileColumns.clear();
@@ -524,16 +511,13 @@ DataMap BiLogBrain::serialize(std::string &name) {
 // given an unordered_map<string, string> and PT, load data into this brain
 void BiLogBrain::deserialize(std::shared_ptr<ParametersTable> PT, std::unordered_map<std::string, std::string> &orgData, std::string &name) {
 	
-	auto brainData = orgData["BRAIN_" + name + "_BiLogBrainGates"];
-
 	std::vector<std::string> brainLayersData;
 	std::vector<int> thisLayersValues;
 
 	gates.clear();
 
-	//std::cout << orgData["BRAIN_" + name + "_BiLogBrainGates"] << std::endl;
-
-	convertCSVListToVector(orgData["BRAIN_" + name + "_BiLogBrainGates"], brainLayersData, '_');
+	// name already has the "BRAIN_" prefix that serialize was given
+	convertCSVListToVector(orgData[name + "_BiLogBrainGates"], brainLayersData, '_');
 	int layerCount = 0;
 	for (auto layerData : brainLayersData) {
 		gates.push_back({}); // make room for this layer
@@ -558,6 +542,22 @@ void BiLogBrain::deserialize(std::shared_ptr<ParametersTable> PT, std::unordered
 	//exit(1);
 
 }
+
+void BiLogBrain::saveCheckpoint(CheckpointWriter &out, std::string &name) {
+	AbstractBrain::saveCheckpoint(out, name);
+	for (auto count : { mutCountLogic1, mutCountLogic2, mutCountLogic3, mutCountLogic4, mutCountWire1, mutCountWire2 }) {
+		out.put(count);
+	}
+	out.put(mutationHistory);
+}
+
+void BiLogBrain::loadCheckpoint(CheckpointReader &in, std::string &name) {
+	AbstractBrain::loadCheckpoint(in, name);
+	for (auto count : { &mutCountLogic1, &mutCountLogic2, &mutCountLogic3, &mutCountLogic4, &mutCountWire1, &mutCountWire2 }) {
+		in.get(*count);
+	}
+	in.get(mutationHistory);
+}
 void
 BiLogBrain::resetBrain() {
 	for (auto &layer : nodes) {
@@ -721,12 +721,12 @@ BiLogBrain::showBrain() {
 
 
 
-void BiLogBrain::mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, int gateID) {
+void BiLogBrain::mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, int gateID, const MutationRates &rates) {
 
 	Gate& gate = newBrain->gates[layerID][gateID];
 
 	// First check for gate logic mutation
-	if (Random::P(mut_logic1)) { // single point logic table mutation (flip 1 bit)
+	if (Random::P(rates.logic1)) { // single point logic table mutation (flip 1 bit)
 		auto pre = gate.logicID;
 		gate.logicID = gate.logic_mutations1[gate.logicID][Random::getIndex(4)]; // 4 options
 		if (recordMutationHistory) {
@@ -734,7 +734,7 @@ void BiLogBrain::mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, i
 		}
 		newBrain->mutCountLogic1 += 1;
 	}
-	if (Random::P(mut_logic2)) {// two point logic table mutation (flip 2 bits)
+	if (Random::P(rates.logic2)) {// two point logic table mutation (flip 2 bits)
 		auto pre = gate.logicID;
 		gate.logicID = gate.logic_mutations2[gate.logicID][Random::getIndex(6)]; // 6 options
 		if (recordMutationHistory) {
@@ -742,7 +742,7 @@ void BiLogBrain::mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, i
 		}
 		newBrain->mutCountLogic2 += 1;
 	}
-	if (Random::P(mut_logic3)) { // three point logic table mutation (flip 3 bits)
+	if (Random::P(rates.logic3)) { // three point logic table mutation (flip 3 bits)
 		auto pre = gate.logicID;
 		gate.logicID = gate.logic_mutations3[gate.logicID][Random::getIndex(4)]; // 4 options
 		if (recordMutationHistory) {
@@ -750,7 +750,7 @@ void BiLogBrain::mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, i
 		}
 		newBrain->mutCountLogic3 += 1;
 	}
-	if (Random::P(mut_logic4)) { // four point logic table mutation (flip all bits)
+	if (Random::P(rates.logic4)) { // four point logic table mutation (flip all bits)
 		auto pre = gate.logicID;
 		gate.logicID = gate.logic_mutations4[gate.logicID][0]; // 1 option (invert gate)
 		if (recordMutationHistory) {
@@ -762,7 +762,7 @@ void BiLogBrain::mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, i
 		// for this layer, we can mutate wires. If there is only one, there is nowhere to mutate. if
 		// 0, the brain is probably a mess...
 
-		if (Random::P(mut_wires1)) { // mutate one wire to this gate
+		if (Random::P(rates.wires1)) { // mutate one wire to this gate
 			newBrain->mutCountWire1 += 1;
 			if (Random::P(.5)) { // 50% chance to mutate left wire
 
@@ -801,7 +801,7 @@ void BiLogBrain::mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, i
 			}
 		}
 
-		if (Random::P(mut_wires2)) { // mutate both wires to this gate
+		if (Random::P(rates.wires2)) { // mutate both wires to this gate
 			newBrain->mutCountWire2 += 1;
 			// mutate the left wire
 			auto randWireID = Random::getIndex(connections[layerID].size() - 1);
@@ -840,107 +840,60 @@ void BiLogBrain::mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, i
 	}
 }
 
-void BiLogBrain::setMutationRates() {
+BiLogBrain::MutationRates BiLogBrain::pickOneMutation(const MutationRates &rates) {
+	double totMut = rates.logic1 + rates.logic2 + rates.logic3 + rates.logic4 + rates.wires1 + rates.wires2;
+	double ratios[6];
+	ratios[0] = rates.logic1 / totMut;
+	ratios[1] = ratios[0] + (rates.logic2 / totMut);
+	ratios[2] = ratios[1] + (rates.logic3 / totMut);
+	ratios[3] = ratios[2] + (rates.logic4 / totMut);
+	ratios[4] = ratios[3] + (rates.wires1 / totMut);
+	ratios[5] = ratios[4] + (rates.wires2 / totMut);
+
 	// determine the type of mutation
 	double mutPick = Random::getDouble(1.0);
-	if (mutPick < mut_logic1_ratio) {
-		mut_logic1 = 1.0;
-		mut_logic2 = 0.0;
-		mut_logic3 = 0.0;
-		mut_logic4 = 0.0;
-		mut_wires1 = 0.0;
-		mut_wires2 = 0.0;
-	}
-	else if (mutPick < mut_logic2_ratio) {
-		mut_logic1 = 0.0;
-		mut_logic2 = 1.0;
-		mut_logic3 = 0.0;
-		mut_logic4 = 0.0;
-		mut_wires1 = 0.0;
-		mut_wires2 = 0.0;
-	}
-	else if (mutPick < mut_logic3_ratio) {
-		mut_logic1 = 0.0;
-		mut_logic2 = 0.0;
-		mut_logic3 = 1.0;
-		mut_logic4 = 0.0;
-		mut_wires1 = 0.0;
-		mut_wires2 = 0.0;
-	}
-	else if (mutPick < mut_logic4_ratio) {
-		mut_logic1 = 0.0;
-		mut_logic2 = 0.0;
-		mut_logic3 = 0.0;
-		mut_logic4 = 1.0;
-		mut_wires1 = 0.0;
-		mut_wires2 = 0.0;
-	}
-	else if (mutPick < mut_wires1_ratio) {
-		mut_logic1 = 0.0;
-		mut_logic2 = 0.0;
-		mut_logic3 = 0.0;
-		mut_logic4 = 0.0;
-		mut_wires1 = 1.0;
-		mut_wires2 = 0.0;
-	}
-	else if (mutPick < mut_wires2_ratio) {
-		mut_logic1 = 0.0;
-		mut_logic2 = 0.0;
-		mut_logic3 = 0.0;
-		mut_logic4 = 0.0;
-		mut_wires1 = 0.0;
-		mut_wires2 = 1.0;
+	MutationRates picked = rates;
+	double *pickedRates[6] = { &picked.logic1, &picked.logic2, &picked.logic3, &picked.logic4, &picked.wires1, &picked.wires2 };
+	for (int type = 0; type < 6; type++) {
+		if (mutPick < ratios[type]) {
+			for (int other = 0; other < 6; other++) {
+				*pickedRates[other] = (other == type) ? 1.0 : 0.0;
+			}
+			break;
+		}
 	}
+	return picked;
 }
 
 std::shared_ptr<AbstractBrain>
 BiLogBrain::makeBrainFrom(std::shared_ptr<AbstractBrain> parent, std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) {
 
-	// if Global::updates catches up to mutProg_updates next entry then add 1 to
-	// mutProgIndex so that we used the next set of mutation rates.
-	if (mutProgIndex + 1 < mutProg_updates.size() && mutProg_updates[mutProgIndex + 1] == Global::update) {
-		mutProgIndex++;
+	// use the last set of mutation rates whose update Global::update has reached.
+	// the index is found from Global::update (rather than counted up) so that
+	// offspring can be made on many threads at once.
+	int progIndex = 0;
+	while (progIndex + 1 < static_cast<int>(mutProg_updates.size()) && mutProg_updates[progIndex + 1] <= Global::update) {
+		progIndex++;
 	}
-	if (mutProg_updates.size() > 0 && Global::update >= mutProg_updates[mutProgIndex]) {
-		mut_logic1 = mutProg_mutLogic1[mutProgIndex];
-		mut_logic2 = mutProg_mutLogic2[mutProgIndex];
-		mut_logic3 = mutProg_mutLogic3[mutProgIndex];
-		mut_logic4 = mutProg_mutLogic4[mutProgIndex];
-		mut_wires1 = mutProg_mutWire1[mutProgIndex];
-		mut_wires2 = mutProg_mutWire2[mutProgIndex];
-
-		mutOneBrain = mutProg_onePerBrain[mutProgIndex];
-		mutOneGate = mutProg_onePerGate[mutProgIndex];
-	}
-
-
-
-	if (mutOneBrain > 0 || mutOneGate > 0) {
-		//double totMut = std::min(1.0, mut_logic1 + mut_logic2 + mut_logic3 + mut_logic4 + mut_wires1 + mut_wires2);
-		double totMut = mut_logic1 + mut_logic2 + mut_logic3 + mut_logic4 + mut_wires1 + mut_wires2;
-		mut_logic1_ratio = mut_logic1 / totMut;
-		mut_logic2_ratio = mut_logic1_ratio + (mut_logic2 / totMut);
-		mut_logic3_ratio = mut_logic2_ratio + (mut_logic3 / totMut);
-		mut_logic4_ratio = mut_logic3_ratio + (mut_logic4 / totMut);
-		mut_wires1_ratio = mut_logic4_ratio + (mut_wires1 / totMut);
-		mut_wires2_ratio = mut_wires1_ratio + (mut_wires2 / totMut);
-		//std::cout << mut_logic1_ratio << "  " << mut_logic2_ratio << "  " << mut_logic3_ratio << "  "
-		//	<< mut_logic4_ratio << "  " << mut_wires1_ratio << "  " << mut_wires2_ratio << std::endl;
+	MutationRates rates = { mut_logic1, mut_logic2, mut_logic3, mut_logic4, mut_wires1, mut_wires2, mutOneBrain, mutOneGate };
+	if (mutProg_updates.size() > 0 && Global::update >= mutProg_updates[progIndex]) {
+		rates = { mutProg_mutLogic1[progIndex], mutProg_mutLogic2[progIndex], mutProg_mutLogic3[progIndex], mutProg_mutLogic4[progIndex],
+			mutProg_mutWire1[progIndex], mutProg_mutWire2[progIndex], mutProg_onePerBrain[progIndex], mutProg_onePerGate[progIndex] };
 	}
 
 	auto parentBrain = std::dynamic_pointer_cast<BiLogBrain>(parent);
 	auto newBrain = std::dynamic_pointer_cast<BiLogBrain>(parent->makeCopy(PT));
 
 	//check for mutOneBrain
-	if (mutOneBrain > 0) {
-		if (Random::P(mutOneBrain)) {
+	if (rates.oneBrain > 0) {
+		if (Random::P(rates.oneBrain)) {
 			// if mutOneBrain is being used (>0) and we rolled for a mutation
 			// determine the type of mutation
-			setMutationRates();
+			auto picked = pickOneMutation(rates);
 			//What layer, what gate?
 			auto layerIndex = layersWithGates[Random::getIndex(layersWithGates.size())];
 			auto gateIndex = Random::getIndex(newBrain->gates[layerIndex].size());
-			mutateGate(newBrain, layerIndex, gateIndex);
+			mutateGate(newBrain, layerIndex, gateIndex, picked);
 		}
 	}
 	else
@@ -948,16 +901,15 @@ BiLogBrain::makeBrainFrom(std::shared_ptr<AbstractBrain> parent, std::unordered_
 		for (int layerIndex = 0; layerIndex < gates.size(); layerIndex++) {
 			for (int gateIndex = 0; gateIndex < gates[layerIndex].size(); gateIndex++) {
 				//check for mutOneGate
-				if (mutOneGate > 0) {
-					if (Random::P(mutOneGate)) {
+				if (rates.oneGate > 0) {
+					if (Random::P(rates.oneGate)) {
 						// if mutOneBrain is being used (>0) and we rolled for a mutation
-						setMutationRates();
 						// mutate this gate
-						mutateGate(newBrain, layerIndex, gateIndex);
+						mutateGate(newBrain, layerIndex, gateIndex, pickOneMutation(rates));
 					}
 				}
 				else { // mutate gate with mutation rates (possible for more then one mutation per gate)
-					mutateGate(newBrain, layerIndex, gateIndex);
+					mutateGate(newBrain, layerIndex, gateIndex, rates);
 				}
 			}
 		}
@@ -34,6 +34,9 @@ public:
 	DataMap serialize(std::string &name)  override;
 	// given an unordered_map<string, string> and PT, load data into this brain
 	void deserialize(std::shared_ptr<ParametersTable> PT, std::unordered_map<std::string, std::string> &orgData, std::string &name) override;
+	// gates (as serialize) and the mutation counts
+	void saveCheckpoint(CheckpointWriter &out, std::string &name) override;
+	void loadCheckpoint(CheckpointReader &in, std::string &name) override;
 
     virtual void resetBrain() override;
 
@@ -120,12 +123,12 @@ public:
     double mut_logic1, mut_logic2, mut_logic3, mut_logic4, mut_wires1, mut_wires2;
 	double mutOneBrain, mutOneGate;
 
-	double mut_logic1_ratio = 0;
-	double mut_logic2_ratio = 0;
-	double mut_logic3_ratio = 0;
-	double mut_logic4_ratio = 0;
-	double mut_wires1_ratio = 0;
-	double mut_wires2_ratio = 0;
+	// the rates one offspring is mutated with. makeBrainFrom works on a copy
+	// of these, since siblings are made from the same parent on many threads.
+	struct MutationRates {
+		double logic1, logic2, logic3, logic4, wires1, wires2;
+		double oneBrain, oneGate;
+	};
 
 	int R, Hnum; // recurent nodes and number of hidden layers
 	std::vector<int> Hsizes; //how big is each hidden layer
@@ -215,8 +218,10 @@ private:
         a.insert(a.end(), b.begin(), b.end());
     }
 
-	void mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, int gateID);
-	void setMutationRates();
+	void mutateGate(std::shared_ptr<BiLogBrain> newBrain, int layerID, int gateID, const MutationRates &rates);
+	// rates with one mutation type (picked in proportion to rates) set to 1.0
+	// and the others to 0.0, for mutOneBrain and mutOneGate
+	static MutationRates pickOneMutation(const MutationRates &rates);
 
 	public:
 
@@ -64,12 +64,9 @@ CGPBrain::CGPBrain(int _nrInNodes, int _nrOutNodes,
     : AbstractBrain(_nrInNodes, _nrOutNodes, PT_) {
 
   convertCSVListToVector(availableOperatorsPL->get(PT), availableOperators);
-  // nrHiddenValues = (PT == nullptr) ? hiddenNodesPL->lookup() :
-  // PT->lookupInt("BRAIN_CGP-hiddenNodes");
-  // magnitudeMax = (PT == nullptr) ? magnitudeMaxPL->lookup() :
-  // PT->lookupDouble("BRAIN_CGP-magnitudeMax");
-  // magnitudeMin = (PT == nullptr) ? magnitudeMinPL->lookup() :
-  // PT->lookupDouble("BRAIN_CGP-magnitudeMin");
+  nrHiddenValues = hiddenNodesPL->get(PT);
+  magnitudeMax = magnitudeMaxPL->get(PT);
+  magnitudeMin = magnitudeMinPL->get(PT);
   // numOpsPreVector = (PT == nullptr) ? numOpsPreVectorPL->lookup() :
   // PT->lookupInt("BRAIN_CGP-operatorsPreFormula");
 
@@ -78,8 +75,7 @@ CGPBrain::CGPBrain(int _nrInNodes, int _nrOutNodes,
   // codonMax = (PT == nullptr) ? codonMaxPL->lookup() :
   // PT->lookupInt("BRAIN_CGP-codonMax");
 
-  // readFromOutputs = (PT == nullptr) ? readFromOutputsPL->lookup() :
-  // PT->lookupBool("BRAIN_CGP-readFromOutputs");
+  readFromOutputs = readFromOutputsPL->get(PT);
 
   allOps = {{"SUM", 0}, {"MULT", 1}, {"SUBTRACT", 2}, {"DIVIDE", 3},
             {"SIN", 4}, {"COS", 5},  {"THRESH", 6},   {"RAND", 7},
@@ -102,10 +98,9 @@ CGPBrain::CGPBrain(int _nrInNodes, int _nrOutNodes,
 
   availableOpsCount = availableOps.size();
 
-  nrInputTotal = nrInputValues +
-                 ((readFromOutputsPL->get(PT)) ? nrOutputValues : 0) +
-                 hiddenNodesPL->get(PT);
-  nrOutputTotal = nrOutputValues + hiddenNodesPL->get(PT);
+  nrInputTotal = nrInputValues + ((readFromOutputs) ? nrOutputValues : 0) +
+                 nrHiddenValues;
+  nrOutputTotal = nrOutputValues + nrHiddenValues;
 
   readFromValues.resize(nrInputTotal, 0);
   writeToValues.resize(nrOutputTotal, 0);
@@ -346,6 +341,55 @@ CGPBrain::CGPBrain(
               << buildModePL->get(PT) << "\".\n exiting." << std::endl;
     exit(1);
   }
+  compile();
+}
+
+void CGPBrain::compile() {
+  const int randOp = allOps["RAND"];
+  program.clear();
+  formulaResults.assign(brainVectors.size(), -1);
+  int firstValue = nrInputTotal; // value written by the formulas first instruction
+  for (int vec = 0; vec < (int)brainVectors.size(); vec++) {
+    const std::vector<int> &code = brainVectors[vec];
+    int nrInstructions = (int)code.size() / 3;
+
+    // mark instructions the formula result depends on, working back from the
+    // last one (instructions only read values from instructions before them)
+    std::vector<bool> live(nrInstructions, false);
+    if (nrInstructions > 0) {
+      live.back() = true;
+    }
+    for (int i = nrInstructions - 1; i >= 0; i--) {
+      if (code[i * 3] == randOp) {
+        live[i] = true;
+      }
+      if (live[i]) {
+        for (int in = 1; in <= 2; in++) {
+          if (code[i * 3 + in] >= nrInputTotal) {
+            live[code[i * 3 + in] - nrInputTotal] = true;
+          }
+        }
+      }
+    }
+
+    for (int i = 0; i < nrInstructions; i++) {
+      if (live[i]) {
+        program.push_back(code[i * 3]);
+        for (int in = 1; in <= 2; in++) {
+          int index = code[i * 3 + in];
+          program.push_back(index < nrInputTotal
+                                ? index
+                                : firstValue + (index - nrInputTotal));
+        }
+        program.push_back(firstValue + i);
+      }
+    }
+    // an empty formula returns the last value that can be read from
+    formulaResults[vec] = (nrInstructions > 0) ? firstValue + nrInstructions - 1
+                                               : nrInputTotal - 1;
+    firstValue += nrInstructions;
+  }
+  readFromValues.assign(firstValue, 0);
 }
 
 void CGPBrain::resetBrain() {
@@ -361,157 +405,79 @@ void CGPBrain::update() {
        index++) { // copy input values into readFromValues
     readFromValues[index] = inputValues[index];
   }
-  if (readFromOutputsPL->get(PT)) { // if readFromOutputs, then add last outputs
+  if (readFromOutputs) { // if readFromOutputs, then add last outputs
     for (int index = 0; index < nrOutputValues; index++) {
       readFromValues[index + nrInputValues] = writeToValues[index];
     }
   }
-  for (int index = nrOutputValues;
-       index < nrOutputValues + hiddenNodesPL->get(PT);
+  for (int index = nrOutputValues; index < nrOutputValues + nrHiddenValues;
        index++) { // add hidden values from writeToValues
     readFromValues[index + nrInputValues -
-                   ((!readFromOutputsPL->get(PT)) ? nrOutputValues : 0)] =
+                   ((!readFromOutputs) ? nrOutputValues : 0)] =
         writeToValues[(index)];
   }
 
-  DataMap dataMap;
-  std::vector<double> values;
-
 #if CGPBRAIN_DEBUG == 1
   std::cout << "***********************************\nSTART"
             << "\n";
+  const char *opNames[] = {"SUM", "MULT",   "SUBTRACT", "DIVIDE", "SIN",
+                           "COS", "THRESH", "RAND",     "IF",     "INV"};
 #endif
-  auto magnitudeMax = magnitudeMaxPL->get(PT);
-  auto magnitudeMin = magnitudeMinPL->get(PT);
-  for (int vec = 0; vec < (int)brainVectors.size(); vec++) {
-#if CGPBRAIN_DEBUG == 1
-    std::cout << "vec: " << vec << "\n";
-#endif
-    values.clear();
-    values = readFromValues;
-    for (int site = 0; site < (int)brainVectors[vec].size(); site += 3) {
-      double op1 = values[brainVectors[vec][site + 1]];
-      double op2 = values[brainVectors[vec][site + 2]];
-      switch (brainVectors[vec][site]) {
-
-      case 0: // SUM
+  double *values = readFromValues.data();
+  const int *code = program.data();
+  const int *end = code + program.size();
+  for (; code != end; code += 4) {
+    double op1 = values[code[1]];
+    double op2 = values[code[2]];
 #if CGPBRAIN_DEBUG == 1
-        std::cout << "SUM(" << brainVectors[vec][site + 1] << "=" << op1 << ","
-                  << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                  << "\n";
+    std::cout << opNames[code[0]] << "(" << code[1] << "=" << op1 << ","
+              << code[2] << "=" << op2 << ") -> " << code[3] << "\n";
 #endif
-        values.push_back(
-            std::min(magnitudeMax, std::max(magnitudeMin, op1 + op2)));
-        break;
-      case 1: // MULT
-#if CGPBRAIN_DEBUG == 1
-        std::cout << "MULT(" << brainVectors[vec][site + 1] << "=" << op1 << ","
-                  << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                  << "\n";
-#endif
-        values.push_back(
-            std::min(magnitudeMax, std::max(magnitudeMin, op1 * op2)));
-        break;
-      case 2: // SUBTRACT
-#if CGPBRAIN_DEBUG == 1
-        std::cout << "SUBTRACT(" << brainVectors[vec][site + 1] << "=" << op1
-                  << "," << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                  << "\n";
-#endif
-        values.push_back(
-            std::min(magnitudeMax, std::max(magnitudeMin, op1 - op2)));
-        break;
-      case 3: // DIVIDE
-        if (op2 == 0) {
-#if CGPBRAIN_DEBUG == 1
-          std::cout << "DIVIDE**0**(" << brainVectors[vec][site + 1] << "="
-                    << op1 << "," << brainVectors[vec][site + 2] << "=" << op2
-                    << ")"
-                    << "\n";
-#endif
-          values.push_back(0);
-        } else {
-#if CGPBRAIN_DEBUG == 1
-          std::cout << "DIVIDE(" << brainVectors[vec][site + 1] << "=" << op1
-                    << "," << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                    << "\n";
-#endif
-          values.push_back(
-              std::min(magnitudeMax, std::max(magnitudeMin, op1 / op2)));
-        }
-        break;
-      case 4: // SIN
-#if CGPBRAIN_DEBUG == 1
-        std::cout << "SIN(" << brainVectors[vec][site + 1] << "=" << op1 << ","
-                  << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                  << "\n";
-#endif
-        values.push_back(
-            std::min(magnitudeMax, std::max(magnitudeMin, sin(op1))));
-        break;
-      case 5: // COS
-#if CGPBRAIN_DEBUG == 1
-        std::cout << "COS(" << brainVectors[vec][site + 1] << "=" << op1 << ","
-                  << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                  << "\n";
-#endif
-        values.push_back(
-            std::min(magnitudeMax, std::max(magnitudeMin, cos(op1))));
-        break;
-
-      case 6: // THRESH
-#if CGPBRAIN_DEBUG == 1
-        std::cout << "THRESH(" << brainVectors[vec][site + 1] << "=" << op1
-                  << "," << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                  << "\n";
-#endif
-        values.push_back(std::min(
-            magnitudeMax, std::max(magnitudeMin, (op1 > op2) ? op2 : op1)));
-        break;
-      case 7: // RAND
-#if CGPBRAIN_DEBUG == 1
-        std::cout << "RAND(" << brainVectors[vec][site + 1] << "=" << op1 << ","
-                  << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                  << "\n";
-#endif
-        values.push_back(std::min(
-            magnitudeMax, std::max(magnitudeMin, Random::getDouble(op1, op2))));
-        break;
-      case 8: // IF
-#if CGPBRAIN_DEBUG == 1
-        std::cout << "IF(" << brainVectors[vec][site + 1] << "=" << op1 << ","
-                  << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                  << "\n";
-#endif
-        values.push_back(std::min(magnitudeMax,
-                                  std::max(magnitudeMin, (op1 > 0) ? op2 : 0)));
-        break;
-      case 9: // INV
-#if CGPBRAIN_DEBUG == 1
-        std::cout << "INV(" << brainVectors[vec][site + 1] << "=" << op1 << ","
-                  << brainVectors[vec][site + 2] << "=" << op2 << ")"
-                  << "\n";
-#endif
-        values.push_back(
-            std::min(magnitudeMax, std::max(magnitudeMin, -1.0 * op1)));
-        break;
+    double value = 0;
+    switch (code[0]) {
+    case 0: // SUM
+      value = op1 + op2;
+      break;
+    case 1: // MULT
+      value = op1 * op2;
+      break;
+    case 2: // SUBTRACT
+      value = op1 - op2;
+      break;
+    case 3: // DIVIDE
+      if (op2 == 0) {
+        values[code[3]] = 0; // not clipped
+        continue;
       }
-#if CGPBRAIN_DEBUG == 1
-      std::cout << "values: ";
-      for (auto v : values) {
-        std::cout << v << " ";
-      }
-      std::cout << "\n";
-      std::cout << "outputValues: ";
-      for (auto v : outputValues) {
-        std::cout << v << " ";
-      }
-      std::cout << "\n";
-#endif
+      value = op1 / op2;
+      break;
+    case 4: // SIN
+      value = sin(op1);
+      break;
+    case 5: // COS
+      value = cos(op1);
+      break;
+    case 6: // THRESH
+      value = (op1 > op2) ? op2 : op1;
+      break;
+    case 7: // RAND
+      value = Random::getDouble(op1, op2);
+      break;
+    case 8: // IF
+      value = (op1 > 0) ? op2 : 0;
+      break;
+    case 9: // INV
+      value = -1.0 * op1;
+      break;
     }
-    writeToValues[vec] = values.back();
+    values[code[3]] = std::min(magnitudeMax, std::max(magnitudeMin, value));
+  }
+
+  for (int vec = 0; vec < (int)formulaResults.size(); vec++) {
+    double result = (formulaResults[vec] < 0) ? 0 : values[formulaResults[vec]];
+    writeToValues[vec] = result;
     if (vec < nrOutputValues) {
-      outputValues[vec] = values.back();
+      outputValues[vec] = result;
     }
   }
 }
@@ -551,5 +517,6 @@ CGPBrain::makeCopy(std::shared_ptr<ParametersTable> PT_) {
   auto newBrain =
       std::make_shared<CGPBrain>(nrInputValues, nrOutputValues, PT_);
   newBrain->brainVectors = brainVectors;
+  newBrain->compile();
   return newBrain;
 }
@@ -25,7 +25,7 @@
 class CGPBrain : public AbstractBrain {
 public:
   static std::shared_ptr<ParameterLink<int>> hiddenNodesPL;
-  // int nrHiddenValues;
+  int nrHiddenValues;
 
   static std::shared_ptr<ParameterLink<std::string>> genomeNamePL;
   // std::string genomeName;
@@ -35,8 +35,8 @@ public:
 
   static std::shared_ptr<ParameterLink<double>> magnitudeMaxPL;
   static std::shared_ptr<ParameterLink<double>> magnitudeMinPL;
-  // double magnitudeMax;
-  // double magnitudeMin;
+  double magnitudeMax;
+  double magnitudeMin;
 
   static std::shared_ptr<ParameterLink<int>> numOpsPreVectorPL;
   // int numOpsPreVector;
@@ -48,10 +48,11 @@ public:
   // int codonMax;
 
   static std::shared_ptr<ParameterLink<bool>> readFromOutputsPL;
-  // bool readFromOutputs;
+  bool readFromOutputs;
 
   std::vector<double> readFromValues; // list of values that can be read from
-                                 // (inputs, outputs, hidden)
+                                 // (inputs, outputs, hidden) followed by one
+                                 // value for each instruction in brainVectors
   std::vector<double> writeToValues;  // list of values that can be written to (there
                                  // will be this number of trees) (outputs,
                                  // hidden)
@@ -65,6 +66,13 @@ public:
 
   std::vector<std::vector<int>> brainVectors; // instruction sets (op,in1,in2)
 
+  // brainVectors compiled into one list of (op,in1,in2,result) indexes into
+  // readFromValues. instructions that no formula result depends on are left
+  // out (RAND is always kept, so random numbers are drawn as before)
+  std::vector<int> program;
+  std::vector<int> formulaResults; // index of each formulas result, -1 if none
+  void compile();
+
   CGPBrain() = delete;
 
   CGPBrain(int _nrInNodes, int _nrOutNodes,
@@ -10,6 +10,8 @@
 
 #include "LSTMBrain.h"
 
+#include <algorithm>
+
 std::shared_ptr<ParameterLink<std::string>> LSTMBrain::genomeNamePL =
     Parameters::register_parameter("BRAIN_LSTM_NAMES-genomeNameSpace",
                                    (std::string) "root::",
@@ -62,20 +64,13 @@ std::shared_ptr<AbstractBrain> LSTMBrain::makeBrain(
   newBrain->C.resize(O_);
   newBrain->H.resize(O_);
   newBrain->X.resize(I_ + O_);
-  newBrain->Wf.resize(I_ + O_);
-  newBrain->Wi.resize(I_ + O_);
-  newBrain->Wc.resize(I_ + O_);
-  newBrain->Wo.resize(I_ + O_);
+  newBrain->W.resize((I_ + O_) * 4 * O_);
+  newBrain->Z.resize(4 * O_);
   newBrain->bt.resize(O_);
   newBrain->bi.resize(O_);
   newBrain->bC.resize(O_);
   newBrain->bO.resize(O_);
 
-  newBrain->ft.resize(O_);
-  newBrain->it.resize(O_);
-  newBrain->Ct.resize(O_);
-  newBrain->Ot.resize(O_);
-  newBrain->dt.resize(O_);
   for (int i = 0; i < O_; i++) {
     newBrain->bt[i] = genomeHandler->readDouble(-1.0, 1.0);
     newBrain->bi[i] = genomeHandler->readDouble(-1.0, 1.0);
@@ -83,15 +78,12 @@ std::shared_ptr<AbstractBrain> LSTMBrain::makeBrain(
     newBrain->bO[i] = genomeHandler->readDouble(-1.0, 1.0);
   }
   for (int i = 0; i < I_ + O_; i++) {
-    newBrain->Wf[i].clear();
-    newBrain->Wi[i].clear();
-    newBrain->Wc[i].clear();
-    newBrain->Wo[i].clear();
+    double *row = newBrain->W.data() + i * 4 * O_;
     for (int j = 0; j < O_; j++) {
-      newBrain->Wf[i].push_back(genomeHandler->readDouble(-1.0, 1.0));
-      newBrain->Wi[i].push_back(genomeHandler->readDouble(-1.0, 1.0));
-      newBrain->Wc[i].push_back(genomeHandler->readDouble(-1.0, 1.0));
-      newBrain->Wo[i].push_back(genomeHandler->readDouble(-1.0, 1.0));
+      row[j] = genomeHandler->readDouble(-1.0, 1.0);          // Wf
+      row[O_ + j] = genomeHandler->readDouble(-1.0, 1.0);     // Wi
+      row[2 * O_ + j] = genomeHandler->readDouble(-1.0, 1.0); // Wc
+      row[3 * O_ + j] = genomeHandler->readDouble(-1.0, 1.0); // Wo
     }
   }
 
@@ -134,37 +126,77 @@ void LSTMBrain::resetBrain() {
   }
 }
 
+// z[o] += x[i] * w[i * width + o] for each row i in turn. four rows are added
+// per pass over z, but each z[o] still sees the rows in order, so the sums are
+// the same as adding one row at a time
+static void addWeightedRows(const double *x, const double *w, int nrRows,
+                            int width, double *z) {
+  int i = 0;
+  for (; i + 4 <= nrRows; i += 4) {
+    const double x0 = x[i], x1 = x[i + 1], x2 = x[i + 2], x3 = x[i + 3];
+    const double *r0 = w + i * width;
+    const double *r1 = r0 + width, *r2 = r1 + width, *r3 = r2 + width;
+    for (int o = 0; o < width; o++) {
+      double sum = z[o];
+      sum += x0 * r0[o];
+      sum += x1 * r1[o];
+      sum += x2 * r2[o];
+      sum += x3 * r3[o];
+      z[o] = sum;
+    }
+  }
+  for (; i < nrRows; i++) {
+    const double value = x[i];
+    const double *row = w + i * width;
+    for (int o = 0; o < width; o++)
+      z[o] += value * row[o];
+  }
+}
+
 void LSTMBrain::update() {
   for (int i = 0; i < I_; i++)
     X[i] = inputValues[i];
-  singleLayerUpdate(X, ft, Wf);
-  vectorMathElementalPlus(ft, bt, ft);
-  vectorMathSigmoid(ft);
-
-  singleLayerUpdate(X, it, Wi);
-  vectorMathElementalPlus(it, bi, it);
-  vectorMathSigmoid(it);
-
-  singleLayerUpdate(X, Ct, Wc);
-  vectorMathElementalPlus(Ct, bC, Ct);
-  vectorMathTanh(Ct);
-
-  singleLayerUpdate(X, Ot, Wo);
-  vectorMathElementalPlus(Ot, bO, Ot);
-  vectorMathSigmoid(Ot);
-  vectorMathElementalMultiply(C, ft, C);
-  vectorMathElementalMultiply(it, Ct, Ct);
-  vectorMathElementalPlus(C, Ct, C);
-  for (int o = 0; o < O_; o++)
-    dt[o] = C[o];
-  vectorMathTanh(dt);
-  vectorMathElementalMultiply(Ot, dt, H);
+  gateSums(X.data(), Z.data());
+  cellUpdate(Z.data(), C.data(), H.data());
   for (int o = 0; o < O_; o++) {
     X[o + I_] = H[o];
     outputValues[o] = H[o];
   }
 }
 
+void LSTMBrain::updateBatch(const std::vector<std::vector<double>> &inputs,
+                            std::vector<std::vector<double>> &outputs,
+                            int updates) {
+  const int lanes = (int)inputs.size();
+  const int nrX = I_ + O_;
+  std::vector<double> laneX(lanes * nrX, 0.0), laneC(lanes * O_, 0.0),
+      laneH(lanes * O_, 0.0), laneZ(lanes * 4 * O_);
+  for (int l = 0; l < lanes; l++)
+    for (int i = 0; i < I_ && i < (int)inputs[l].size(); i++)
+      laneX[l * nrX + i] = inputs[l][i];
+
+  for (int u = 0; u < updates; u++) {
+    // gateSums for every lane, a few rows of W at a time so they stay in
+    // cache while all lanes use them
+    std::fill(laneZ.begin(), laneZ.end(), 0.0);
+    for (int i = 0; i < nrX; i += 8) {
+      const int rows = std::min(8, nrX - i);
+      for (int l = 0; l < lanes; l++)
+        addWeightedRows(laneX.data() + l * nrX + i, W.data() + i * 4 * O_,
+                        rows, 4 * O_, laneZ.data() + l * 4 * O_);
+    }
+    for (int l = 0; l < lanes; l++) {
+      double *h = laneH.data() + l * O_;
+      cellUpdate(laneZ.data() + l * 4 * O_, laneC.data() + l * O_, h);
+      std::copy(h, h + O_, laneX.begin() + l * nrX + I_);
+    }
+  }
+
+  outputs.resize(lanes);
+  for (int l = 0; l < lanes; l++)
+    outputs[l].assign(laneH.begin() + l * O_, laneH.begin() + (l + 1) * O_);
+}
+
 void inline LSTMBrain::resetOutputs() {
   for (int o = 0; o < O_; o++) {
     H[o] = 0.0;
@@ -275,43 +307,20 @@ valueMax);
    */
 }
 
-void LSTMBrain::singleLayerUpdate(std::vector<double> &IN,
-                                  std::vector<double> &OUT,
-                                  std::vector<std::vector<double>> &W) {
-  int I = (int)IN.size();
-  int O = (int)OUT.size();
-  for (int o = 0; o < O; o++)
-    OUT[o] = 0.0;
-  for (int i = 0; i < I; i++)
-    for (int o = 0; o < O; o++) {
-      OUT[o] += IN[i] * W[i][o];
-    }
-}
-
-void LSTMBrain::vectorMathSigmoid(std::vector<double> &V) {
-  for (auto &&v : V)
-    v = fastSigmoid(v);
+void LSTMBrain::gateSums(const double *x, double *z) const {
+  std::fill(z, z + 4 * O_, 0.0);
+  addWeightedRows(x, W.data(), I_ + O_, 4 * O_, z);
 }
 
-void LSTMBrain::vectorMathTanh(std::vector<double> &V) {
-  for (auto &&v : V)
-    v = tanh(v);
-}
-
-void LSTMBrain::vectorMathElementalPlus(std::vector<double> &A,
-                                        std::vector<double> &B,
-                                        std::vector<double> &result) {
-  int L = (int)A.size();
-  for (int i = 0; i < L; i++)
-    result[i] = A[i] + B[i];
-}
-
-void LSTMBrain::vectorMathElementalMultiply(std::vector<double> &A,
-                                            std::vector<double> &B,
-                                            std::vector<double> &result) {
-  int L = (int)A.size();
-  for (int i = 0; i < L; i++)
-    result[i] = A[i] * B[i];
+void LSTMBrain::cellUpdate(const double *z, double *c, double *h) const {
+  for (int o = 0; o < O_; o++) {
+    double ft = fastSigmoid(z[o] + bt[o]);
+    double it = fastSigmoid(z[O_ + o] + bi[o]);
+    double Ct = tanh(z[2 * O_ + o] + bC[o]);
+    double Ot = fastSigmoid(z[3 * O_ + o] + bO[o]);
+    c[o] = c[o] * ft + it * Ct;
+    h[o] = Ot * tanh(c[o]);
+  }
 }
 
 void LSTMBrain::showVector(std::vector<double> &V) {
@@ -331,15 +340,8 @@ LSTMBrain::makeCopy(std::shared_ptr<ParametersTable> PT_) {
   newBrain->I_ = I_;
   newBrain->O_ = O_;
 
-  newBrain->Wf = Wf;
-  newBrain->Wi = Wi;
-  newBrain->Wc = Wc;
-  newBrain->Wo = Wo;
-  newBrain->ft = ft;
-  newBrain->it = it;
-  newBrain->Ct = Ct;
-  newBrain->Ot = Ot;
-  newBrain->dt = dt;
+  newBrain->W = W;
+  newBrain->Z = Z;
   newBrain->bt = bt;
   newBrain->bi = bi;
   newBrain->bC = bC;
@@ -28,11 +28,13 @@ public:
 
   std::string genomeName;
 
-  std::vector<std::vector<double>> Wf, Wi, Wc, Wo;
-  std::vector<double> ft, it, Ct, Ot, dt;
+  // Wf, Wi, Wc and Wo stacked into one row-major (I_ + O_) x (4 * O_) matrix.
+  // row i holds the weights from X[i] to ft, it, Ct and Ot (O_ values each)
+  std::vector<double> W;
   std::vector<double> bt, bi, bC, bO;
   int I_, O_;
   std::vector<double> C, X, H;
+  std::vector<double> Z; // weighted sums for ft, it, Ct and Ot
 
   LSTMBrain() = delete;
 
@@ -42,6 +44,10 @@ public:
   virtual ~LSTMBrain() = default;
 
   virtual void update() override;
+  // all lanes are stepped together, so each row of W is used for every lane
+  virtual void updateBatch(const std::vector<std::vector<double>> &inputs,
+                           std::vector<std::vector<double>> &outputs,
+                           int updates = 1) override;
 
   virtual std::shared_ptr<AbstractBrain>
   makeBrain(std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>
@@ -58,16 +64,11 @@ public:
       std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>
           &_genomes) override;
 
-  double fastSigmoid(double value) { return value / (1.0 + fabs(value)); }
-  void singleLayerUpdate(std::vector<double> &IN, std::vector<double> &out,
-                         std::vector<std::vector<double>> &W);
-  void vectorMathSigmoid(std::vector<double> &V);
-  void vectorMathTanh(std::vector<double> &V);
-  void vectorMathElementalPlus(std::vector<double> &A, std::vector<double> &B,
-                               std::vector<double> &result);
-  void vectorMathElementalMultiply(std::vector<double> &A,
-                                   std::vector<double> &B,
-                                   std::vector<double> &result);
+  double fastSigmoid(double value) const { return value / (1.0 + fabs(value)); }
+  // z (4 * O_ values) = x (I_ + O_ values) times W
+  void gateSums(const double *x, double *z) const;
+  // add biases, apply activations and update cell state c and output h
+  void cellUpdate(const double *z, double *c, double *h) const;
   void showVector(std::vector<double> &V);
 
   virtual std::shared_ptr<AbstractBrain>
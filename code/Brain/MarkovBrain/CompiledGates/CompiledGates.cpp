@@ -0,0 +1,251 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "CompiledGates.h"
+
+#include <algorithm>
+
+#include <Brain/MarkovBrain/Gate/DeterministicGate.h>
+#include <Brain/MarkovBrain/Gate/ProbabilisticGate.h>
+#include <Utilities/Random.h>
+
+CompiledGates::CompiledGates(
+    const std::vector<std::shared_ptr<AbstractGate>> &gates) {
+  inputStarts.push_back(0);
+  outputStarts.push_back(0);
+  for (auto const &gate : gates) {
+    // check gateType() (and not only the class) so that derived gates with
+    // their own update() (i.e. Epsilon, Void) are not compiled as their base
+    auto type = gate->gateType();
+    if (type == "Deterministic" && gate->outputs.size() <= 32) {
+      auto detGate = std::dynamic_pointer_cast<DeterministicGate>(gate);
+      std::vector<uint32_t> masks;
+      bool binary = detGate != nullptr;
+      for (size_t row = 0; binary && row < detGate->table.size(); row++) {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < gate->outputs.size(); i++) {
+          binary = binary && (detGate->table[row][i] == 0 ||
+                              detGate->table[row][i] == 1);
+          mask |= static_cast<uint32_t>(detGate->table[row][i] & 1) << i;
+        }
+        masks.push_back(mask);
+      }
+      if (binary) {
+        types.push_back(DETERMINISTIC);
+        tableStarts.push_back(static_cast<int>(outputMasks.size()));
+        outputMasks.insert(outputMasks.end(), masks.begin(), masks.end());
+        addInputsAndOutputs(gate);
+        continue;
+      }
+    } else if (type == "Probabilistic") {
+      auto probGate = std::dynamic_pointer_cast<ProbabilisticGate>(gate);
+      if (probGate != nullptr) {
+        types.push_back(PROBABILISTIC);
+        tableStarts.push_back(static_cast<int>(probabilities.size()));
+        probabilities.insert(probabilities.end(),
+                             probGate->sampler.cumulative.begin(),
+                             probGate->sampler.cumulative.end());
+        addInputsAndOutputs(gate);
+        continue;
+      }
+    }
+    types.push_back(OTHER);
+    tableStarts.push_back(static_cast<int>(otherGates.size()));
+    otherGates.push_back(gate);
+    addInputsAndOutputs(gate);
+  }
+}
+
+void CompiledGates::addInputsAndOutputs(
+    const std::shared_ptr<AbstractGate> &gate) {
+  inputNodes.insert(inputNodes.end(), gate->inputs.begin(),
+                    gate->inputs.end());
+  outputNodes.insert(outputNodes.end(), gate->outputs.begin(),
+                     gate->outputs.end());
+  inputStarts.push_back(static_cast<int>(inputNodes.size()));
+  outputStarts.push_back(static_cast<int>(outputNodes.size()));
+}
+
+void CompiledGates::update(std::vector<double> &nodes,
+                           std::vector<double> &nextNodes) const {
+  const double *in = nodes.data();
+  double *out = nextNodes.data();
+  const int nrOps = static_cast<int>(types.size());
+  for (int op = 0; op < nrOps; op++) {
+    if (types[op] == OTHER) {
+      otherGates[tableStarts[op]]->update(nodes, nextNodes);
+      continue;
+    }
+
+    // same as vectorToBitToInt(nodes, inputs, true) - first input is the
+    // lowest bit
+    int input = 0;
+    for (int k = inputStarts[op + 1] - 1; k >= inputStarts[op]; k--) {
+      input = input * 2 + (in[inputNodes[k]] > 0.0);
+    }
+    const int *outputs = outputNodes.data() + outputStarts[op];
+    const int nrOutputs = outputStarts[op + 1] - outputStarts[op];
+
+    if (types[op] == DETERMINISTIC) {
+      uint32_t mask = outputMasks[tableStarts[op] + input];
+      for (int i = 0; i < nrOutputs; i++) {
+        out[outputs[i]] += (mask >> i) & 1;
+      }
+    } else { // PROBABILISTIC, see ProbabilisticGate::update
+      const int nrColumns = 1 << nrOutputs;
+      const double *row =
+          probabilities.data() + tableStarts[op] + input * nrColumns;
+      int outputColumn =
+          ProbabilityTable::sample(row, nrColumns, Random::getDouble(1));
+      for (int i = 0; i < nrOutputs; i++) {
+        out[outputs[i]] += 1.0 * ((outputColumn >> (nrOutputs - 1 - i)) & 1);
+      }
+    }
+  }
+}
+
+bool PackedGates::canPack(
+    const std::vector<std::shared_ptr<AbstractGate>> &gates) {
+  for (auto const &gate : gates) {
+    if (gate->gateType() != "Deterministic" || gate->outputs.size() > 32) {
+      return false;
+    }
+    auto detGate = std::dynamic_pointer_cast<DeterministicGate>(gate);
+    if (detGate == nullptr) {
+      return false;
+    }
+    for (auto const &row : detGate->table) {
+      for (auto value : row) {
+        if (value != 0 && value != 1) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+PackedGates::PackedGates(
+    const std::vector<std::shared_ptr<AbstractGate>> &gates, int _nrNodes,
+    int firstOutput, int _nrOutputs)
+    : words((_nrNodes + 63) / 64), nrNodes(_nrNodes), nrOutputs(_nrOutputs) {
+  inputStarts.push_back(0);
+  outputStarts.push_back(0);
+  countStarts.push_back(0);
+  for (auto const &gate : gates) {
+    auto detGate = std::dynamic_pointer_cast<DeterministicGate>(gate);
+    tableStarts.push_back(static_cast<int>(rowMasks.size()));
+    maxRows = std::max(maxRows, static_cast<int>(detGate->table.size()));
+    for (auto const &row : detGate->table) {
+      uint32_t mask = 0;
+      std::vector<uint64_t> on(words, 0);
+      for (size_t i = 0; i < gate->outputs.size(); i++) {
+        if (row[i]) {
+          mask |= uint32_t(1) << i;
+          int node = gate->outputs[i];
+          on[node / 64] |= uint64_t(1) << (node % 64);
+        }
+      }
+      rowMasks.push_back(mask);
+      onWords.insert(onWords.end(), on.begin(), on.end());
+    }
+
+    inputNodes.insert(inputNodes.end(), gate->inputs.begin(),
+                      gate->inputs.end());
+    inputStarts.push_back(static_cast<int>(inputNodes.size()));
+    outputNodes.insert(outputNodes.end(), gate->outputs.begin(),
+                       gate->outputs.end());
+    outputStarts.push_back(static_cast<int>(outputNodes.size()));
+
+    for (size_t i = 0; i < gate->outputs.size(); i++) {
+      int output = gate->outputs[i] - firstOutput;
+      if (output >= 0 && output < nrOutputs) {
+        countColumns.push_back(static_cast<int>(i));
+        countOutputs.push_back(output);
+      }
+    }
+    countStarts.push_back(static_cast<int>(countOutputs.size()));
+  }
+}
+
+void PackedGates::update(const uint64_t *nodes, uint64_t *nextNodes,
+                         double *outputCounts) const {
+  std::fill(nextNodes, nextNodes + words, uint64_t(0));
+  std::fill(outputCounts, outputCounts + nrOutputs, 0.0);
+
+  const int nrGates = static_cast<int>(tableStarts.size());
+  for (int gate = 0; gate < nrGates; gate++) {
+    // first input is the lowest bit (see CompiledGates::update)
+    int input = 0;
+    for (int k = inputStarts[gate + 1] - 1; k >= inputStarts[gate]; k--) {
+      int node = inputNodes[k];
+      input = input * 2 + static_cast<int>((nodes[node / 64] >> (node % 64)) & 1);
+    }
+    int row = tableStarts[gate] + input;
+    const uint64_t *on = onWords.data() + row * words;
+    for (int w = 0; w < words; w++) {
+      nextNodes[w] |= on[w];
+    }
+    for (int c = countStarts[gate]; c < countStarts[gate + 1]; c++) {
+      outputCounts[countOutputs[c]] += (rowMasks[row] >> countColumns[c]) & 1;
+    }
+  }
+}
+
+void PackedGates::updateLanes(const uint64_t *laneNodes,
+                              uint64_t *nextLaneNodes, double *outputCounts,
+                              uint64_t laneMask) const {
+  std::fill(nextLaneNodes, nextLaneNodes + nrNodes, uint64_t(0));
+  if (outputCounts != nullptr) {
+    std::fill(outputCounts, outputCounts + 64 * nrOutputs, 0.0);
+  }
+
+  // matches[p] has the bit of every lane where the gate sees input pattern p
+  std::vector<uint64_t> matches(maxRows);
+  uint64_t columns[32];
+  const int nrGates = static_cast<int>(tableStarts.size());
+  for (int gate = 0; gate < nrGates; gate++) {
+    // split the lanes on each input in turn, first input is the lowest bit
+    int rows = 1;
+    matches[0] = ~uint64_t(0);
+    for (int k = inputStarts[gate]; k < inputStarts[gate + 1]; k++) {
+      uint64_t in = laneNodes[inputNodes[k]];
+      for (int p = 0; p < rows; p++) {
+        matches[p + rows] = matches[p] & in;
+        matches[p] &= ~in;
+      }
+      rows *= 2;
+    }
+
+    const uint32_t *table = rowMasks.data() + tableStarts[gate];
+    const int nrColumns = outputStarts[gate + 1] - outputStarts[gate];
+    for (int c = 0; c < nrColumns; c++) {
+      uint64_t on = 0;
+      for (int p = 0; p < rows; p++) {
+        if ((table[p] >> c) & 1) {
+          on |= matches[p];
+        }
+      }
+      columns[c] = on;
+      nextLaneNodes[outputNodes[outputStarts[gate] + c]] |= on;
+    }
+
+    if (outputCounts != nullptr) {
+      for (int c = countStarts[gate]; c < countStarts[gate + 1]; c++) {
+        uint64_t on = columns[countColumns[c]] & laneMask;
+        for (int lane = 0; on != 0; lane++, on >>= 1) {
+          if (on & 1) {
+            outputCounts[lane * nrOutputs + countOutputs[c]] += 1.0;
+          }
+        }
+      }
+    }
+  }
+}
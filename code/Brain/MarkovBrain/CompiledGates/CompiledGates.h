@@ -0,0 +1,120 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Brain/MarkovBrain/Gate/AbstractGate.h>
+
+// A list of gates "compiled" into flat arrays. Deterministic and Probabilistic
+// gates are run from these arrays in a single loop (no virtual calls, no
+// vector<vector> tables). Any other type of gate is kept and its update() is
+// called in turn, so every gate list can be compiled and gates always run in
+// the same order (and draw the same random numbers) as the gate list.
+//
+// The program is a copy of the gates at the time it was made. If the gate list
+// (or a gates table) changes, the program must be made again.
+class CompiledGates {
+public:
+  CompiledGates() = default;
+  explicit CompiledGates(const std::vector<std::shared_ptr<AbstractGate>> &gates);
+
+  // same as calling update(nodes, nextNodes) on each gate in the gate list
+  void update(std::vector<double> &nodes, std::vector<double> &nextNodes) const;
+
+private:
+  enum OpType : unsigned char { DETERMINISTIC, PROBABILISTIC, OTHER };
+
+  // one entry per gate. inputs (and outputs) of gate i are
+  // inputNodes[inputStarts[i]] to inputNodes[inputStarts[i + 1] - 1]
+  std::vector<OpType> types;
+  std::vector<int> inputStarts;
+  std::vector<int> outputStarts;
+  std::vector<int> tableStarts; // index into the table used by this gate type
+
+  std::vector<int> inputNodes;
+  std::vector<int> outputNodes;
+
+  // deterministic gates - one mask per input pattern, bit i is output i
+  std::vector<uint32_t> outputMasks;
+  // probabilistic gates - one row of 2^outputs running sums (see
+  // ProbabilityTable) per input pattern
+  std::vector<double> probabilities;
+  // everything else
+  std::vector<std::shared_ptr<AbstractGate>> otherGates;
+
+  void addInputsAndOutputs(const std::shared_ptr<AbstractGate> &gate);
+};
+
+// A gate list made only of (binary) Deterministic gates, run on bit packed
+// node state. Node n is bit (n % 64) of word (n / 64). For each gate and
+// input pattern the bits the gate turns on are stored as whole words, so a
+// gate costs one gather of its inputs and one OR per word of state.
+//
+// Gates add their outputs into nextNodes in the gate list, so a node written
+// by two gates holds 2. Here those writes are OR-ed (which is the same for
+// every use of the next state, since gates only test "> 0"), but the number of
+// writes to each output node is still counted so that output values are
+// exactly as if the gates had been run.
+class PackedGates {
+public:
+  PackedGates() = default;
+  PackedGates(const std::vector<std::shared_ptr<AbstractGate>> &gates,
+              int nrNodes, int firstOutput, int nrOutputs);
+
+  // true if every gate in gates is a Deterministic gate with a 0/1 table
+  static bool canPack(const std::vector<std::shared_ptr<AbstractGate>> &gates);
+
+  int nrWords() const { return words; }
+
+  // run all gates on nodes (nrWords() words). nextNodes is overwritten.
+  // outputCounts[i] is set to the value update() on the gates would leave in
+  // nextNodes for output node i.
+  void update(const uint64_t *nodes, uint64_t *nextNodes,
+              double *outputCounts) const;
+
+  // run all gates on up to 64 copies of the brain at once ("lanes"). here
+  // laneNodes holds one word per node and bit l of each word is the value of
+  // that node in lane l. nextLaneNodes is overwritten. if outputCounts is not
+  // null, outputCounts[l * nrOutputs + i] is set as in update() for each lane
+  // l in laneMask.
+  void updateLanes(const uint64_t *laneNodes, uint64_t *nextLaneNodes,
+                   double *outputCounts, uint64_t laneMask) const;
+
+private:
+  int words = 1;
+  int nrNodes = 0;
+  int nrOutputs = 0;
+  int maxRows = 1; // largest table
+
+  // inputs of gate i are inputNodes[inputStarts[i]] to
+  // inputNodes[inputStarts[i + 1] - 1]
+  std::vector<int> inputStarts;
+  std::vector<int> inputNodes;
+  // words turned on by gate i for input pattern p start at
+  // onWords[(tableStarts[i] + p) * words]
+  std::vector<int> tableStarts;
+  std::vector<uint64_t> onWords;
+  // outputs of gate i are outputNodes[outputStarts[i]] to
+  // outputNodes[outputStarts[i + 1] - 1]
+  std::vector<int> outputStarts;
+  std::vector<int> outputNodes;
+
+  // gate outputs that write to output nodes: for gate i, entries
+  // countStarts[i] to countStarts[i + 1] - 1 hold the table column and the
+  // output index
+  std::vector<int> countStarts;
+  std::vector<int> countColumns;
+  std::vector<int> countOutputs;
+  std::vector<uint32_t> rowMasks; // table row as bits, one per input pattern
+};
@@ -66,6 +66,7 @@ DecomposableFeedbackGate::DecomposableFeedbackGate(pair<vector<int>, vector<int>
       }
   }
   originalTable = table; // initial copy
+  sampler = ProbabilityTable(table);
 
   chosenInPos.clear();
   chosenInNeg.clear();
@@ -106,6 +107,7 @@ void DecomposableFeedbackGate::update(vector<double> & states, vector<double> &
           }
           double rowSum( accumulate(begin(table[chosenInPos[i]]), end(table[chosenInPos[i]]), 0.) ); /// sum row
           for (auto& number : table[chosenInPos[i]]) number /= rowSum; /// divide row by sum
+          sampler.setRow(rowi, table[rowi]);
           //table[chosenInPos[i]][chosenOutPos[i]] += mod;
           //double s = 0.0;
           //for (size_t k = 0; k < table[chosenInPos[i]].size(); k++)
@@ -139,6 +141,7 @@ void DecomposableFeedbackGate::update(vector<double> & states, vector<double> &
           }
           double rowSum( accumulate(begin(table[chosenInNeg[i]]), end(table[chosenInNeg[i]]), 0.) ); /// sum row
           for (auto& number : table[chosenInNeg[i]]) number /= rowSum; /// divide row by sum
+          sampler.setRow(rowi, table[rowi]);
           //transform( begin(table[chosenInNeg[i]]), end(table[chosenInNeg[i]]), begin(table[chosenInNeg[i]]), bind1st(divides<T>(), rowSum) ); /// divide row by sum
           //table[chosenInNeg[i]][chosenOutNeg[i]] -= mod;
           //if (table[chosenInNeg[i]][chosenOutNeg[i]] < 0.001)
@@ -153,14 +156,10 @@ void DecomposableFeedbackGate::update(vector<double> & states, vector<double> &
 
   //do the logic of the gate
   int input = 0;
-  int output = 0;
   double r = Random::getDouble(1);
   for (size_t i = 0; i < inputs.size(); i++)
       input = (input << 1) + Bit(states[inputs[i]]);
-  while (r > table[input][output]) {
-      r -= table[input][output];
-      output++;
-  }
+  int output = sampler.sample(input, r);
   for (size_t i = 0; i < outputs.size(); i++)
       nextStates[outputs[i]] += 1.0 * ((output >> i) & 1);
 
@@ -216,9 +215,11 @@ void DecomposableFeedbackGate::resetGate() {
   chosenOutNeg.clear();
     appliedNegFB.clear();
     appliedPosFB.clear();
-  for (size_t i = 0; i < table.size(); i++)
+  for (size_t i = 0; i < table.size(); i++) {
     for (size_t j = 0; j < table[i].size(); j++)
       table[i][j] = originalTable[i][j];
+    sampler.setRow(i, table[i]);
+  }
     string temp;
 }
 
@@ -299,6 +300,7 @@ shared_ptr<AbstractGate> DecomposableFeedbackGate::makeCopy(shared_ptr<Parameter
 	}
 	auto newGate = make_shared<DecomposableFeedbackGate>(_PT);
 	newGate->table = originalTable; // non-Lamarkian
+	newGate->sampler = ProbabilityTable(originalTable);
     originalTable = originalTable;
     feedbackON = feedbackON;
     posFBNode = posFBNode;
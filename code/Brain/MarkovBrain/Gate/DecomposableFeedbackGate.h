@@ -11,6 +11,7 @@
 #pragma once
 
 #include "AbstractGate.h"
+#include "ProbabilityTable.h"
 
 using namespace std;
 
@@ -28,6 +29,7 @@ class DecomposableFeedbackGate : public AbstractGate {
   
   vector<vector<double>> table;
   vector<vector<double>> originalTable;
+  ProbabilityTable sampler; // table as running sums, rows are redone when feedback changes them
   vector<vector<double>> factors;
   int ins,outs;
   DecomposableFeedbackGate() = delete;
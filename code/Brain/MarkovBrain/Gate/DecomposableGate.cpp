@@ -40,18 +40,12 @@ DecomposableGate::DecomposableGate(pair<vector<int>, vector<int>> addresses, vec
 				table[i][j] = (double) rawTable[i][j] / S;
 		}
 	}
-
+	sampler = ProbabilityTable(table);
 }
 
 void DecomposableGate::update(vector<double> & nodes, vector<double> & nextNodes) {  //this translates the input bits of the current states to the output bits of the next states
 	int input = vectorToBitToInt(nodes,inputs,true); // converts the input values into an index (true indicates to reverse order)
-	int outputColumn = 0;
-	double r = Random::getDouble(1);  // r will determine with set of outputs will be chosen
-	while (r > table[input][outputColumn]) {
-		r -= table[input][outputColumn];  // this goes across the probability table in row for the given input and subtracts each
-		// value in the table from r until r is less than a value it reaches
-		outputColumn++;  // we have not found the correct output so move to the next output
-	}
+	int outputColumn = sampler.sample(input, Random::getDouble(1));  // pick a column with the probabilities in this row
 	for (size_t i = 0; i < outputs.size(); i++)  //for each output...
 		nextNodes[outputs[i]] += 1.0 * ((outputColumn >> (outputs.size() - 1 - i)) & 1);  // convert output (the column number) to bits and pack into next states
 																						   // but always put the last bit in the first input (to maintain consistancy)
@@ -64,6 +58,7 @@ shared_ptr<AbstractGate> DecomposableGate::makeCopy(shared_ptr<ParametersTable>
 	}
 	auto newGate = make_shared<DecomposableGate>(_PT);
 	newGate->table = table;
+	newGate->sampler = sampler;
 	newGate->ID = ID;
 	newGate->inputs = inputs;
 	newGate->outputs = outputs;
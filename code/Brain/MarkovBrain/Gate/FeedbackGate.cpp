@@ -62,6 +62,7 @@ FeedbackGate::FeedbackGate(pair<vector<int>, vector<int>> addresses,
       }
   }
   originalTable = table; // initial copy
+  sampler = ProbabilityTable(table);
 
   chosenInPos.clear();
   chosenInNeg.clear();
@@ -85,6 +86,7 @@ void FeedbackGate::update(vector<double> & states, vector<double> & nextStates)
         s += table[chosenInPos[i]][k];
       for (size_t k = 0; k < table[chosenInPos[i]].size(); k++)
         table[chosenInPos[i]][k] /= s;
+      sampler.setRow(chosenInPos[i], table[chosenInPos[i]]);
     }
   }
     //default feedback to cut off negative feedback comment section out
@@ -100,19 +102,16 @@ void FeedbackGate::update(vector<double> & states, vector<double> & nextStates)
         s += table[chosenInNeg[i]][k];
       for (size_t k = 0; k < table[chosenInNeg[i]].size(); k++)
         table[chosenInNeg[i]][k] /= s;
+      sampler.setRow(chosenInNeg[i], table[chosenInNeg[i]]);
     }
   }
 
   //do the logic of the gate
   int input = 0;
-  int output = 0;
   double r = Random::getDouble(1);
   for (size_t i = 0; i < inputs.size(); i++)
     input = (input << 1) + Bit(states[inputs[i]]);
-  while (r > table[input][output]) {
-    r -= table[input][output];
-    output++;
-  }
+  int output = sampler.sample(input, r);
   for (size_t i = 0; i < outputs.size(); i++)
     nextStates[outputs[i]] += 1.0 * ((output >> i) & 1);
 
@@ -168,9 +167,11 @@ void FeedbackGate::resetGate() {
   chosenOutNeg.clear();
     appliedNegFB.clear();
     appliedPosFB.clear();
-  for (size_t i = 0; i < table.size(); i++)
+  for (size_t i = 0; i < table.size(); i++) {
     for (size_t j = 0; j < table[i].size(); j++)
       table[i][j] = originalTable[i][j];
+    sampler.setRow(i, table[i]);
+  }
     string temp;
 }
 
@@ -251,6 +252,7 @@ shared_ptr<AbstractGate> FeedbackGate::makeCopy(shared_ptr<ParametersTable> _PT)
 	}
 	auto newGate = make_shared<FeedbackGate>(_PT);
 	newGate->table = originalTable; // non-Lamarkian
+	newGate->sampler = ProbabilityTable(originalTable);
     originalTable = originalTable;
     feedbackON = feedbackON;
     posFBNode = posFBNode;
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "AbstractGate.h"
+#include "ProbabilityTable.h"
 
 using namespace std;
 
@@ -28,6 +29,7 @@ class FeedbackGate : public AbstractGate {
   
   vector<vector<double>> table;
   vector<vector<double>> originalTable;
+  ProbabilityTable sampler; // table as running sums, rows are redone when feedback changes them
   FeedbackGate() = delete;
   FeedbackGate(shared_ptr<ParametersTable> _PT = nullptr) :
   	AbstractGate(_PT) {
@@ -30,7 +30,57 @@ shared_ptr<ParameterLink<int>> NeuronGate::defaultDeliveryChargeFromNodePL = Par
 
 
 std::shared_ptr<ParameterLink<bool>> NeuronGate::record_behaviorPL = Parameters::register_parameter("BRAIN_MARKOV_GATES_NEURON-record_behavior", false, "if true, record neuron behavior (NOTE: this can generate a lot of data!)");
-std::shared_ptr<ParameterLink<std::string>> NeuronGate::record_behavior_file_namePL = Parameters::register_parameter("BRAIN_MARKOV_GATES_NEURON-record_behavior_fileName", (std::string) "neuron_behavior.csv","Name of file where neron behaviors are saved");
+std::shared_ptr<ParameterLink<std::string>> NeuronGate::record_behavior_file_namePL = Parameters::register_parameter("BRAIN_MARKOV_GATES_NEURON-record_behavior_fileName", (std::string) "neuron_behavior.bin","Name of file where neron behaviors are saved (binary, read with displayNeuronBehavior.py)");
+
+shared_ptr<NeuronBehaviorTrace> NeuronBehaviorTrace::get(const string & fileName) {
+	// gates may outlive this (i.e. if exit() is called), so flush here too
+	static struct Traces {
+		map<string, shared_ptr<NeuronBehaviorTrace>> byName;
+		~Traces() {
+			for (auto & t : byName) {
+				t.second->flush();
+			}
+		}
+	} traces;
+	static mutex tracesMutex;
+	lock_guard<mutex> lock(tracesMutex);
+	auto & trace = traces.byName[fileName];
+	if (trace == nullptr) {
+		trace = make_shared<NeuronBehaviorTrace>(FileManager::outputPrefix + fileName);
+	}
+	return trace;
+}
+
+NeuronBehaviorTrace::NeuronBehaviorTrace(const string & _path) : path(_path) {
+	buffer.resize(bufferSize);
+}
+
+NeuronBehaviorTrace::~NeuronBehaviorTrace() {
+	flush();
+}
+
+void NeuronBehaviorTrace::record(const Record & r) {
+	lock_guard<mutex> lock(bufferMutex);
+	buffer[count++] = r;
+	if (count == bufferSize) {
+		write();
+	}
+}
+
+void NeuronBehaviorTrace::flush() {
+	lock_guard<mutex> lock(bufferMutex);
+	write();
+}
+
+void NeuronBehaviorTrace::write() {
+	if (!file.is_open()) {
+		file.open(path, ios::out | ios::binary | ios::trunc);
+		file << "MABE_NEURON_BEHAVIOR 1 ID:i4,fire:i1,thresholdActivates:i1,dischargeBehavior:i1,unused:i1,thresholdValue:f8,currentCharge:f8,deliveryCharge:f8\n";
+	}
+	file.write(reinterpret_cast<const char*>(buffer.data()), count * sizeof(Record));
+	file.flush();
+	count = 0;
+}
 
 void NeuronGate::update(vector<double> & nodes, vector<double> & nextnodes) {
 	bool fire = false;
@@ -55,33 +105,6 @@ void NeuronGate::update(vector<double> & nodes, vector<double> & nextnodes) {
 		}
 	}
 
-	string stateNow = "";
-
-	if (record_behavior) {
-		stateNow += to_string(ID);
-		stateNow += "," + to_string(fire);
-		stateNow += "," + to_string(inputs.size());
-		stateNow += "," + to_string(outputs.size()) + ",\"[";
-		for (int i = 0; i < (int)inputs.size(); i++) {
-			stateNow += to_string(inputs[i]) + ",";
-		}
-		stateNow.pop_back();
-		stateNow += "]\",\"[";
-		for (int i = 0; i < (int)outputs.size(); i++) {
-			stateNow += to_string(outputs[i]) + ",";
-		}
-		stateNow.pop_back();
-		stateNow += "]\"";
-		stateNow += "," + to_string(thresholdValue);
-		stateNow += "," + to_string(currentCharge);
-		stateNow += "," + to_string(dischargeBehavior);
-		stateNow += "," + to_string(decayRate);
-		stateNow += "," + to_string(deliveryError);
-		stateNow += "," + to_string(thresholdActivates);
-		stateNow += "," + to_string(thresholdFromNode);
-		stateNow += "," + to_string(deliveryChargeFromNode);
-	}
-
 	double localDeliveryCharge = 0;
 	if (fire) {
 		//cout << "neuron: " << ID << "  ";
@@ -112,8 +135,16 @@ void NeuronGate::update(vector<double> & nodes, vector<double> & nextnodes) {
 		}
 	}
 	if (record_behavior) {
-		stateNow += "," + to_string(localDeliveryCharge);
-		FileManager::writeToFile(record_behavior_file_name, stateNow, "ID,fire,inCount,outCount,inConnections,outConnections,thresholdValue,currentCharge,dischargeBehavior,decayRate,deliveryError,thresholdActivates,thresholdFromNode,deliveryChargeFromNode,deliveryCharge");  //fileName, data, header
+		NeuronBehaviorTrace::Record r;
+		r.ID = ID;
+		r.fire = fire;
+		r.thresholdActivates = thresholdActivates;
+		r.dischargeBehavior = dischargeBehavior;
+		r.unused = 0;
+		r.thresholdValue = thresholdValue;
+		r.currentCharge = currentCharge;
+		r.deliveryCharge = localDeliveryCharge;
+		behaviorTrace->record(r);
 	}
 }
 
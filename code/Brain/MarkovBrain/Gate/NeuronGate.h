@@ -12,6 +12,49 @@
 
 #include "AbstractGate.h"
 
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+
+// buffer of neuron gate behavior records, shared by all gates that record to
+// the same file. records are written in bulk when the buffer fills and when
+// the program exits. the file is a one line text header followed by Records
+// (native byte order, see displayNeuronBehavior.py for a reader).
+class NeuronBehaviorTrace {
+public:
+	struct Record {
+		int32_t ID;
+		int8_t fire;
+		int8_t thresholdActivates;
+		int8_t dischargeBehavior;
+		int8_t unused;
+		double thresholdValue;
+		double currentCharge;
+		double deliveryCharge;
+	};
+	static_assert(sizeof(Record) == 32, "NeuronBehaviorTrace::Record must not be padded");
+
+	static const int bufferSize = 1 << 14;
+
+	// the trace for fileName (in GLOBAL-outputPrefix), made on first use
+	static shared_ptr<NeuronBehaviorTrace> get(const string & fileName);
+
+	NeuronBehaviorTrace(const string & _path);
+	~NeuronBehaviorTrace();
+
+	void record(const Record & r);
+	void flush();
+
+private:
+	void write(); // caller holds bufferMutex
+
+	string path;
+	ofstream file;
+	vector<Record> buffer;
+	int count = 0;
+	mutex bufferMutex;
+};
+
 class NeuronGate: public AbstractGate {
 public:
 
@@ -35,6 +78,7 @@ public:
 
 	bool record_behavior;
 	string record_behavior_file_name;
+	shared_ptr<NeuronBehaviorTrace> behaviorTrace; // only set if record_behavior
 
 	int dischargeBehavior;  // what to do when the gate delivers a charge
 	double thresholdValue;  // threshold when this gate will fire (if negative, then fire when currentCharge < threshold)
@@ -75,6 +119,9 @@ public:
 
 		record_behavior = record_behaviorPL->get(PT);
 		record_behavior_file_name = record_behavior_file_namePL->get(PT);
+		if (record_behavior) {
+			behaviorTrace = NeuronBehaviorTrace::get(record_behavior_file_name);
+		}
 	}
 	NeuronGate(vector<int> ins, int out, int _dischargeBehavior, double _thresholdValue, bool _thresholdActivates, double _decayRate, double _deliveryCharge, double _deliveryError, int _thresholdFromNode, int _deliveryChargeFromNode, int _ID, shared_ptr<ParametersTable> _PT = nullptr) :
 		AbstractGate(_PT) {
@@ -100,6 +147,9 @@ public:
 
 		record_behavior = record_behaviorPL->get(PT);
 		record_behavior_file_name = record_behavior_file_namePL->get(PT);
+		if (record_behavior) {
+			behaviorTrace = NeuronBehaviorTrace::get(record_behavior_file_name);
+		}
 	}
 
 	virtual ~NeuronGate() = default;
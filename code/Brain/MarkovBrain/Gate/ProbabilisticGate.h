@@ -11,6 +11,7 @@
 #pragma once
 
 #include "AbstractGate.h"
+#include "ProbabilityTable.h"
 
 using namespace std;
 
@@ -20,6 +21,7 @@ public:
 	static shared_ptr<ParameterLink<string>> IO_RangesPL;
 
 	vector<vector<double>> table;
+	ProbabilityTable sampler; // table as running sums, used by update()
 	ProbabilisticGate() = delete;
 	ProbabilisticGate(shared_ptr<ParametersTable> _PT = nullptr) :
 		AbstractGate(_PT) {
@@ -0,0 +1,31 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "ProbabilityTable.h"
+
+ProbabilityTable::ProbabilityTable(const vector<vector<double>> & table) {
+	columns = table.empty() ? 0 : (int)table[0].size();
+	cumulative.resize(table.size() * columns);
+	sortedRows.resize(table.size());
+	for (int row = 0; row < (int)table.size(); row++) {
+		setRow(row, table[row]);
+	}
+}
+
+void ProbabilityTable::setRow(int row, const vector<double> & probabilities) {
+	double sum = 0;
+	bool sorted = true;
+	for (int i = 0; i < columns; i++) {
+		sum += probabilities[i];
+		cumulative[row * columns + i] = sum;
+		sorted = sorted && probabilities[i] >= 0;
+	}
+	sortedRows[row] = sorted;
+}
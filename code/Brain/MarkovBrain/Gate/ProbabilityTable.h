@@ -0,0 +1,52 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+// the rows of a probabilistic gate table as running sums, in one array.
+// picking an output column is then a binary search instead of walking the row.
+class ProbabilityTable {
+public:
+	int columns = 0;
+	vector<double> cumulative; // row r is cumulative[r * columns] to cumulative[(r + 1) * columns - 1]
+	// false if the row has a negative entry (feedback can do this), so its
+	// sums are not sorted and have to be searched in order
+	vector<char> sortedRows;
+
+	ProbabilityTable() = default;
+	ProbabilityTable(const vector<vector<double>> & table);
+
+	// call when a row of the table changes
+	void setRow(int row, const vector<double> & probabilities);
+
+	// the column picked by r (0 <= r < 1) from a row of running sums: the first
+	// column whose sum is >= r, or the last column if rounding leaves r above
+	// them all. this is what subtracting each probability from r in turn does.
+	static int sample(const double * row, int columns, double r) {
+		return (int)(lower_bound(row, row + columns - 1, r) - row);
+	}
+
+	int sample(int row, double r) const {
+		const double * sums = cumulative.data() + row * columns;
+		if (sortedRows[row]) {
+			return sample(sums, columns, r);
+		}
+		int column = 0;
+		while (column < columns - 1 && r > sums[column]) {
+			column++;
+		}
+		return column;
+	}
+};
@@ -6,7 +6,7 @@ import pandas
 import argparse
 parser = argparse.ArgumentParser(description="load and display neuron behavior data. Neuron behavior is generated by neuron gates when the record_behavior parameter in markov brain neuron gates is set to true.")
 
-parser.add_argument('-file', type=str, metavar='FILE', default = 'neuron_behavior.csv',  help='neuron behavior file - default: neuron_behavior.txt', required=False)
+parser.add_argument('-file', type=str, metavar='FILE', default = 'neuron_behavior.bin',  help='neuron behavior file - default: neuron_behavior.bin', required=False)
 parser.add_argument('-pltRange', type=int, metavar=('FIRST','LAST'), default = [0,-1],  help='range over which to show data - default: none (will show all data)', nargs=2, required=False)
 parser.add_argument('-hideFire', action='store_true', default = False, help='if true, fireing data will be hidden - default (if not set) : False', required=False)
 parser.add_argument('-hideCurrentCharge', action='store_true', default = False, help='if true, CurrentCharge will be hidden - default (if not set) : False', required=False)
@@ -42,7 +42,14 @@ plt.rcParams['figure.figsize']=[figureSizeX,figureSizeY]
 print('\nlegend:\n  black = threshold\n  blue = current charge\n  gray dashed = delivery charge\n  shaded area = when gate is active (green=activated/red=repressed)',flush=True)
 
 # load data from file
-data = pandas.read_csv(fileName)
+# a one line header, then fixed size records (see NeuronBehaviorTrace in NeuronGate.h)
+# records are in the byte order of the machine that ran MABE, so this must be run
+# on a machine with the same byte order
+recordType = np.dtype([('ID','=i4'),('fire','i1'),('thresholdActivates','i1'),('dischargeBehavior','i1'),('unused','i1'),
+                       ('thresholdValue','=f8'),('currentCharge','=f8'),('deliveryCharge','=f8')])
+with open(fileName,'rb') as dataFile:
+    dataFile.readline()
+    data = pandas.DataFrame(np.frombuffer(dataFile.read(),dtype=recordType))
 
 # pull the data we need into lists
 IDList = data['ID'].tolist()
@@ -10,9 +10,62 @@
 
 #include "GateListBuilder.h"
 
+#include <algorithm>
+#include <cstring>
+
+// gates that makeCopy reproduces exactly as they were read from the genome, and that do not change as they are used
+static const set<string> reusableGateTypes = { "Deterministic", "Probabilistic", "TritDeterministic", "Decomposable", "DecomposableDirect", "Epsilon" };
+
+// a run of sites that a genome kept unchanged from its editParent
+struct KeptRun {
+	int parent;  // first site in the parent
+	int child;  // first site in the genome
+	int length;
+};
+
+// replay edits on a genome that started as parentSize unchanged sites. runs are returned in order.
+static vector<KeptRun> keptRuns(const vector<AbstractGenome::Edit> & edits, int parentSize) {
+	vector<KeptRun> runs = { { 0, 0, parentSize } };
+	vector<KeptRun> nextRuns;
+	for (auto const & edit : edits) {
+		nextRuns.clear();
+		int editEnd = edit.start + edit.removed;
+		for (auto const & run : runs) {
+			int runEnd = run.child + run.length;
+			if (run.child < edit.start) {  // part before the edit
+				nextRuns.push_back({ run.parent, run.child, min(runEnd, edit.start) - run.child });
+			}
+			if (runEnd > editEnd) {  // part after the edit, moved by the change in size
+				int from = max(run.child, editEnd);
+				nextRuns.push_back({ run.parent + from - run.child, from + edit.inserted - edit.removed, runEnd - from });
+			}
+		}
+		runs.swap(nextRuns);
+	}
+	return runs;
+}
+
 vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllValues(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount, vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT) {
+	return translate(genome, nrOfBrainStates, maxValue, genomeHeadValues, genomeHeadValuesCount, genomePerGateValues, genomePerGateValuesCount, gatePT, nullptr, nullptr, nullptr, nullptr);
+}
+
+vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListFrom(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, shared_ptr<ParametersTable> gatePT,
+                                                                           const GateSites &parentSites, const vector<shared_ptr<AbstractGate>> &parentGates, GateSites &sites, vector<bool> &reused) {
+	vector<int> temp1;
+	vector<vector<int>> temp2;
+	return translate(genome, nrOfBrainStates, 0, temp1, 0, temp2, 0, gatePT, &parentSites, &parentGates, &sites, &reused);
+}
+
+vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::translate(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount, vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT,
+                                                                   const GateSites *parentSites, const vector<shared_ptr<AbstractGate>> *parentGates, GateSites *sites, vector<bool> *reused) {
 
 	vector<shared_ptr<AbstractGate>> gates;
+	if (sites != nullptr) {
+		*sites = GateSites();
+	}
+	if (reused != nullptr) {
+		reused->clear();
+	}
 	int codonMax = (1 << Gate_Builder::bitsPerCodonPL->get(PT)) - 1;
 	bool mustReadAll = codonMax > genome->getAlphabetSize();
 
@@ -36,9 +89,151 @@ vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllV
 
 		int gateCount = 0;
 
-		int testSite1Value, testSite2Value;
-		testSite1Value = genomeHandler->readInt(0, codonMax);
-		testSite2Value = genomeHandler->readInt(0, codonMax);
+		// genomeHandler is just past a start codon beginning with testSite1Value
+		auto makeGateAtStartCodon = [&](int testSite1Value) {
+			genomeHandler->copyTo(gateGenomeHandler);
+			gateGenomeHandler->toggleReadDirection();
+			gateGenomeHandler->readInt(0, codonMax);  // move back 2 start codon values
+			gateGenomeHandler->readInt(0, codonMax);
+			gateGenomeHandler->toggleReadDirection();  // reverse the read direction again
+			gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);  // mark start codon in genomes coding region
+			gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);
+			shared_ptr<AbstractGate> newGate = gateBuilder.makeGate[testSite1Value](gateGenomeHandler, gateCount, gatePT);
+
+			if (newGate != nullptr) {
+				// now read perGate values from genome
+				vector<int> thisGatesValues;
+				int i = 0;
+				while (i < genomePerGateValuesCount && !gateGenomeHandler->atEOC()) {
+					thisGatesValues.push_back(gateGenomeHandler->readInt(0, maxValue));
+					i++;
+				}
+				if (!gateGenomeHandler->atEOC()) {  // we may run out of space while reading the perGate sites...
+					gates.push_back(newGate);
+					genomePerGateValues.push_back(thisGatesValues);
+				}
+			}
+			gateCount++;
+		};
+
+		static thread_local AbstractGenome::SiteBytes bytes;  // kept between calls so it is not reallocated
+		if (!mustReadAll && genome->siteBytes(bytes) && bytes.size > 0) {
+			// the genome is bytes and each codon is one site, so look for start codons directly.
+			// this finds the same start codons as the loop below: every pair of sites except the last two
+			// (which the loop below reaches the end of the chromosome on) and the pair that wraps around.
+			int secondCodon[256];  // for each site value, the codon that must follow it to make a start codon (or -1)
+			int firstSite = -1, firstSitesCount = 0;
+			for (int b = 0; b < 256; b++) {
+				auto const & startCodon = gateBuilder.gateStartCodes[b % (codonMax + 1)];
+				secondCodon[b] = startCodon.size() != 0 ? startCodon[1] : -1;
+				if (secondCodon[b] != -1) {
+					firstSite = b;
+					firstSitesCount++;
+				}
+			}
+			const int genomeSize = bytes.size;
+			const int lastStart = genomeSize - 3;
+
+			auto readGateAt = [&](int k) {
+				int gatesBefore = (int)gates.size();
+				genomeHandler->resetHandler();
+				genomeHandler->advanceIndex(k + 2);
+				makeGateAtStartCodon(bytes[k] % (codonMax + 1));
+				bool madeGate = (int)gates.size() > gatesBefore;
+				if (reused != nullptr && madeGate) {
+					reused->push_back(false);
+				}
+				if (sites != nullptr) {
+					int end = gateGenomeHandler->atEOC() ? -1 : gateGenomeHandler->getSiteIndex();
+					sites->startCodons.push_back({ k, end, madeGate ? (int)gates.size() - 1 : -1 });
+				}
+			};
+			// read a gate at every start codon that begins in [from, to), a page at a time
+			auto readGatesIn = [&](int from, int to) {
+				to = min(to, lastStart + 1);
+				while (from < to) {
+					int pageStart = from - from % bytes.pageSize;
+					int pageEnd = pageStart + bytes.pageSize;
+					const unsigned char * page = bytes.pages[from / bytes.pageSize];
+					int end = min(to, pageEnd);
+					for (int k = from; k < end; k++) {
+						if (firstSitesCount == 1) {  // only one gate type, let memchr find the next candidate
+							auto found = (const unsigned char *)memchr(page + (k - pageStart), firstSite, end - k);
+							if (found == nullptr) {
+								break;
+							}
+							k = pageStart + (int)(found - page);
+						}
+						int site1 = page[k - pageStart];
+						int site2 = k + 1 < pageEnd ? page[k + 1 - pageStart] : bytes[k + 1];  // only the last pair crosses pages
+						if (secondCodon[site1] != -1 && secondCodon[site1] == site2 % (codonMax + 1)) {
+							readGateAt(k);
+						}
+					}
+					from = end;
+				}
+			};
+
+			vector<KeptRun> runs;
+			if (parentSites != nullptr) {
+				auto parentGenome = genome->editParent.lock();
+				if (parentGenome != nullptr && parentGenome == parentSites->genome.lock() && genome->editParentVersion == parentSites->genomeVersion) {
+					runs = keptRuns(genome->edits, parentSites->genomeSize);
+				}
+			}
+			int next = 0;  // start codons before next have been handled
+			for (auto const & run : runs) {
+				// a pair of sites in this run is a start codon here if and only if it was one in the parent,
+				// as long as the parent looked at it
+				int known = min(run.length - 1, parentSites->genomeSize - 2 - run.parent);
+				if (known <= 0) {
+					continue;
+				}
+				readGatesIn(next, run.child);
+				auto const & startCodons = parentSites->startCodons;
+				auto codon = lower_bound(startCodons.begin(), startCodons.end(), run.parent, [](const GateSites::StartCodon & c, int site) {
+					return c.site < site;
+				});
+				for (; codon != startCodons.end() && codon->site < run.parent + known; codon++) {
+					int k = codon->site - run.parent + run.child;
+					if (k > lastStart) {
+						break;
+					}
+					// the gate can be copied if everything it read is in this run, reading it here would not
+					// run off the end of the genome, and nothing before it has (which would drop it)
+					int end = codon->end - run.parent + run.child;
+					bool canCopy = codon->end != -1 && codon->end <= run.parent + run.length && end < genomeSize && !gateGenomeHandler->atEOC() &&
+						(codon->gate == -1 || reusableGateTypes.count((*parentGates)[codon->gate]->gateType()) != 0);
+					if (!canCopy) {
+						readGateAt(k);
+						continue;
+					}
+					if (codon->gate != -1) {
+						auto gate = (*parentGates)[codon->gate]->makeCopy();
+						gate->ID = gateCount;
+						gates.push_back(gate);
+						reused->push_back(true);
+					}
+					sites->startCodons.push_back({ k, end, codon->gate != -1 ? (int)gates.size() - 1 : -1 });
+					gateCount++;
+				}
+				next = max(next, run.child + known);
+			}
+			readGatesIn(next, lastStart + 1);
+
+			if (sites != nullptr) {
+				sites->genome = genome;
+				sites->genomeVersion = genome->version;
+				sites->genomeSize = genomeSize;
+			}
+			translation_Complete = true;
+		}
+
+		int testSite1Value = 0, testSite2Value = 0;
+		if (!translation_Complete) {
+			testSite1Value = genomeHandler->readInt(0, codonMax);
+			testSite2Value = genomeHandler->readInt(0, codonMax);
+		}
 		while (!translation_Complete) {
 			if (genomeHandler->atEOC()) {  // if genomeIndex > testIndex, testIndex has wrapped and we are done translating
 				if (genomeHandler->atEOG()) {
@@ -48,29 +243,7 @@ vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllV
 				genomeHandler->copyTo(placeHolderGenomeHandler);  // move placeholder to the next chromosome aswell so mustReadAll method works
 				testSite2Value = genomeHandler->readInt(0, codonMax);  // place first value in new chromosome in testSite2 so !mustReadAll method works
 			} else if (gateBuilder.gateStartCodes[testSite1Value].size() != 0 && gateBuilder.gateStartCodes[testSite1Value][1] == testSite2Value) {  // if we found a start codon
-					genomeHandler->copyTo(gateGenomeHandler);
-					gateGenomeHandler->toggleReadDirection();
-					gateGenomeHandler->readInt(0, codonMax);  // move back 2 start codon values
-					gateGenomeHandler->readInt(0, codonMax);
-					gateGenomeHandler->toggleReadDirection();  // reverse the read direction again
-					gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);  // mark start codon in genomes coding region
-					gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);
-					shared_ptr<AbstractGate> newGate = gateBuilder.makeGate[testSite1Value](gateGenomeHandler, gateCount, gatePT);
-
-					if (newGate != nullptr) {
-						// now read perGate values from genome
-						vector<int> thisGatesValues;
-						int i = 0;
-						while (i < genomePerGateValuesCount && !gateGenomeHandler->atEOC()) {
-							thisGatesValues.push_back(gateGenomeHandler->readInt(0, maxValue));
-							i++;
-						}
-						if (!gateGenomeHandler->atEOC()) {  // we may run out of space while reading the perGate sites...
-							gates.push_back(newGate);
-							genomePerGateValues.push_back(thisGatesValues);
-						}
-					}
-					gateCount++;
+				makeGateAtStartCodon(testSite1Value);
 			}
 			if (mustReadAll) {  // if start codon values are bigger then the alphabetSize of the genome, we must step forward one genome site at a time (slow)
 				placeHolderGenomeHandler->advanceIndex();
@@ -86,6 +259,9 @@ vector<shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllV
 	}
 //cout << "Leaving GLB\n";
 
+	if (reused != nullptr) {
+		reused->resize(gates.size(), false);
+	}
 	return gates;
 }
 
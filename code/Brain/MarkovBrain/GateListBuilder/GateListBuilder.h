@@ -22,6 +22,22 @@
 #include <Utilities/Parameters.h>
 
 using namespace std;
+
+// where translation found start codons in a genome, and what came of each one.
+// lets a brain built from a mutated copy of that genome reuse gates from the
+// parts of the genome that did not change (see buildGateListFrom)
+struct GateSites {
+	struct StartCodon {
+		int site;  // first site of the start codon
+		int end;  // one past the last site read for the gate, -1 if reading ran off the end of the genome
+		int gate;  // index in the gate list, -1 if no gate was made
+	};
+	vector<StartCodon> startCodons;
+	weak_ptr<AbstractGenome> genome;  // the genome translated, empty if startCodons were not recorded
+	int genomeVersion = 0;
+	int genomeSize = 0;
+};
+
 class AbstractGateListBuilder {
 
  public:
@@ -50,6 +66,17 @@ class AbstractGateListBuilder {
 		return buildGateListAndGetAllValues(genome, nrOfBrainStates, 0, temp1, 0, temp2, 0, gatePT);
 	}
 
+	// buildGateList, and record where gates came from in sites. If genome is a mutated copy of the genome
+	// described by parentSites, gates in unchanged parts of genome may be copied from parentGates instead
+	// of being read again. reused[i] is true if gate i is a copy (it has already been mapped to brain nodes).
+	virtual vector<shared_ptr<AbstractGate>> buildGateListFrom(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, shared_ptr<ParametersTable> gatePT,
+	                                                           const GateSites &parentSites, const vector<shared_ptr<AbstractGate>> &parentGates, GateSites &sites, vector<bool> &reused){
+		sites = GateSites();
+		auto gates = buildGateList(genome, nrOfBrainStates, gatePT);
+		reused.assign(gates.size(), false);
+		return gates;
+	}
+
 	virtual vector<shared_ptr<AbstractGate>> buildGateListAndGetHeadValues(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount, shared_ptr<ParametersTable> gatePT){
 		vector<vector<int>> temp;
 		return buildGateListAndGetAllValues(genome, nrOfBrainStates, maxValue, genomeHeadValues, genomeHeadValuesCount, temp, 0, gatePT);
@@ -80,5 +107,15 @@ class ClassicGateListBuilder : public AbstractGateListBuilder {
 	virtual vector<shared_ptr<AbstractGate>> buildGateListAndGetAllValues(shared_ptr<AbstractGenome> genome, int nrOfBrainStates,
 	                                               int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount,
 	                                               vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT);
+
+	virtual vector<shared_ptr<AbstractGate>> buildGateListFrom(shared_ptr<AbstractGenome> genome, int nrOfBrainStates, shared_ptr<ParametersTable> gatePT,
+	                                                           const GateSites &parentSites, const vector<shared_ptr<AbstractGate>> &parentGates, GateSites &sites, vector<bool> &reused) override;
+
+ protected:
+	// buildGateListAndGetAllValues, with the extra arguments of buildGateListFrom (which may be nullptr)
+	vector<shared_ptr<AbstractGate>> translate(shared_ptr<AbstractGenome> genome, int nrOfBrainStates,
+	                                           int maxValue, vector<int> &genomeHeadValues, int genomeHeadValuesCount,
+	                                           vector<vector<int>> &genomePerGateValues, int genomePerGateValuesCount, shared_ptr<ParametersTable> gatePT,
+	                                           const GateSites *parentSites, const vector<shared_ptr<AbstractGate>> *parentGates, GateSites *sites, vector<bool> *reused);
 };
 
@@ -10,6 +10,8 @@
 
 #include "MarkovBrain.h"
 
+#include <algorithm>
+
 std::shared_ptr<ParameterLink<bool>> MarkovBrain::recordIOMapPL=
     Parameters::register_parameter(
         "BRAIN_MARKOV_ADVANCED-recordIOMap", false,
@@ -18,6 +20,20 @@ std::shared_ptr<ParameterLink<std::string>> MarkovBrain::IOMapFileNamePL=
     Parameters::register_parameter("BRAIN_MARKOV_ADVANCED-recordIOMap_fileName",
                                    (std::string) "markov_IO_map.csv",
                                    "Name of file where IO mappings are saved");
+std::shared_ptr<ParameterLink<bool>> MarkovBrain::compileGatesPL =
+    Parameters::register_parameter(
+        "BRAIN_MARKOV_ADVANCED-compileGates", true,
+        "if true, Deterministic and Probabilistic gates are converted into "
+        "flat lookup tables when the brain is built, which makes updates "
+        "faster. Brains with only Deterministic gates also store node states "
+        "as bits. results are the same either way");
+std::shared_ptr<ParameterLink<bool>> MarkovBrain::reuseGatesPL =
+    Parameters::register_parameter(
+        "BRAIN_MARKOV_ADVANCED-reuseGates", true,
+        "if true, a brain built from a mutated copy of its parent's genome "
+        "copies the parent's gates from parts of the genome that did not "
+        "change instead of reading them again. results are the same either "
+        "way");
 std::shared_ptr<ParameterLink<bool>> MarkovBrain::randomizeUnconnectedOutputsPL =
     Parameters::register_parameter(
         "BRAIN_MARKOV_ADVANCED-randomizeUnconnectedOutputs", false,
@@ -57,6 +73,9 @@ void MarkovBrain::readParameters() {
   randomizeUnconnectedOutputsMin = randomizeUnconnectedOutputsMinPL->get(PT);
   randomizeUnconnectedOutputsMax = randomizeUnconnectedOutputsMaxPL->get(PT);
   hiddenNodes = hiddenNodesPL->get(PT);
+  recordIOMap = recordIOMapPL->get();
+  compileGates = compileGatesPL->get(PT);
+  reuseGates = reuseGatesPL->get(PT);
 
   genomeName = genomeNamePL->get(PT);
 
@@ -75,6 +94,7 @@ MarkovBrain::MarkovBrain(std::vector<std::shared_ptr<AbstractGate>> _gates,
   // GLB = nullptr;
   GLB = std::make_shared<ClassicGateListBuilder>(PT);
   gates = _gates;
+  compile();
   // columns to be added to ave file
   popFileColumns.clear();
   popFileColumns.push_back("markovBrainGates");
@@ -110,14 +130,67 @@ MarkovBrain::MarkovBrain(std::shared_ptr<AbstractGateListBuilder> GLB_,
 MarkovBrain::MarkovBrain(
     std::shared_ptr<AbstractGateListBuilder> GLB_,
     std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes, int _nrInNodes,
-    int _nrOutNodes, std::shared_ptr<ParametersTable> PT_)
+    int _nrOutNodes, std::shared_ptr<ParametersTable> PT_,
+    const MarkovBrain *parent)
     : MarkovBrain(GLB_, _nrInNodes, _nrOutNodes, PT_) {
   // cout << "in MarkovBrain::MarkovBrain(std::shared_ptr<Base_GateListBuilder> GLB_,
   // std::shared_ptr<AbstractGenome> genome, int _nrOfBrainStates)\n\tabout to -
   // gates = GLB->buildGateList(genome, nrOfBrainStates);" << endl;
-  gates = GLB->buildGateList(_genomes[genomeName], nrNodes, PT_);
-  inOutReMap(); // map ins and outs from genome values to brain states
+  std::vector<bool> reused;
+  if (reuseGates) {
+    // with no parent this only records gateSites
+    static const GateSites noSites;
+    static const std::vector<std::shared_ptr<AbstractGate>> noGates;
+    gates = GLB->buildGateListFrom(_genomes[genomeName], nrNodes, PT_,
+                                   parent ? parent->gateSites : noSites,
+                                   parent ? parent->gates : noGates,
+                                   gateSites, reused);
+  } else {
+    gates = GLB->buildGateList(_genomes[genomeName], nrNodes, PT_);
+  }
+  inOutReMap(reused); // map ins and outs from genome values to brain states
   fillInConnectionsLists();
+  compile();
+}
+
+void MarkovBrain::compile() {
+  // deterministic gates only see Bit() of the nodes they read, so Bit() of
+  // every node is all an update depends on
+  cacheUpdates = updateCache.enabled() && !randomizeUnconnectedOutputs &&
+                 !recordIOMap &&
+                 std::all_of(gates.begin(), gates.end(), [](auto const &g) {
+                   return g->gateType() == "Deterministic";
+                 });
+
+  if (!compileGates) {
+    return;
+  }
+  compiledGates = CompiledGates(gates);
+
+  // bit packed nodes can not hold random outputs or be recorded
+  binaryNodes = !randomizeUnconnectedOutputs && !recordIOMap &&
+                PackedGates::canPack(gates);
+  if (binaryNodes) {
+    packedGates = PackedGates(gates, nrNodes, nrInputValues, nrOutputValues);
+    nodeBits.assign(packedGates.nrWords(), 0);
+    nextNodeBits.assign(packedGates.nrWords(), 0);
+    packNodes();
+  }
+}
+
+void MarkovBrain::unpackNodes() {
+  if (binaryNodes) {
+    for (int i = 0; i < nrNodes; i++)
+      nodes[i] = (nodeBits[i / 64] >> (i % 64)) & 1;
+  }
+}
+
+void MarkovBrain::packNodes() {
+  if (binaryNodes) {
+    nodeBits.assign(nodeBits.size(), 0);
+    for (int i = 0; i < nrNodes; i++)
+      nodeBits[i / 64] |= uint64_t(Bit(nodes[i])) << (i % 64);
+  }
 }
 
 // Make a brain like the brain that called this function, using genomes and
@@ -129,40 +202,179 @@ std::shared_ptr<AbstractBrain> MarkovBrain::makeBrain(
   return newBrain;
 }
 
+std::shared_ptr<AbstractBrain> MarkovBrain::makeBrainFrom(
+    std::shared_ptr<AbstractBrain> parent,
+    std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) {
+  auto markovParent = std::dynamic_pointer_cast<MarkovBrain>(parent);
+  return std::make_shared<MarkovBrain>(GLB, _genomes, nrInputValues,
+                                       nrOutputValues, PT, markovParent.get());
+}
+
+// gates can only be reused from a parent whose genome this genome was copied
+// from, so only the first parent is worth checking
+std::shared_ptr<AbstractBrain> MarkovBrain::makeBrainFromMany(
+    std::vector<std::shared_ptr<AbstractBrain>> parents,
+    std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) {
+  if (parents.empty())
+    return makeBrain(_genomes);
+  return makeBrainFrom(parents[0], _genomes);
+}
+
 void MarkovBrain::resetBrain() {
   AbstractBrain::resetBrain();
   nodes.assign(nrNodes, 0.0);
+  nodeBits.assign(nodeBits.size(), 0);
   for (auto &g :gates)
 	  g->resetGate();
 }
 
 void MarkovBrain::resetInputs() {
   AbstractBrain::resetInputs(); 
+  unpackNodes();
   for (int i = 0; i < nrInputValues; i++)
     nodes[i] = 0.0;
+  packNodes();
 }
 
 void MarkovBrain::resetOutputs() {
   AbstractBrain::resetOutputs();
   // note nrInputValues+i gets us the index for the node related to each output
+  unpackNodes();
   for (int i = 0; i < nrOutputValues; i++) 
     nodes[nrInputValues + i] = 0.0;
+  packNodes();
 }
 
 
+void MarkovBrain::updateBatch(const std::vector<std::vector<double>> &inputs,
+                              std::vector<std::vector<double>> &outputs,
+                              int updates) {
+  if (!binaryNodes) {
+    AbstractBrain::updateBatch(inputs, outputs, updates);
+    return;
+  }
+
+  // one word per node, bit l is lane l. the brain's own state is not used
+  std::vector<uint64_t> laneNodes(nrNodes), nextLaneNodes(nrNodes);
+  std::vector<uint64_t> laneInputs(nrInputValues);
+  std::vector<double> counts(64 * nrOutputValues);
+  const int nrLanes = static_cast<int>(inputs.size());
+  outputs.resize(nrLanes);
+  for (int first = 0; first < nrLanes; first += 64) {
+    int lanes = std::min(64, nrLanes - first);
+    uint64_t laneMask = lanes == 64 ? ~uint64_t(0) : (uint64_t(1) << lanes) - 1;
+    laneInputs.assign(nrInputValues, 0);
+    for (int l = 0; l < lanes; l++) {
+      auto const &in = inputs[first + l];
+      for (int i = 0; i < nrInputValues && i < static_cast<int>(in.size()); i++)
+        if (in[i] > 0.0)
+          laneInputs[i] |= uint64_t(1) << l;
+    }
+
+    laneNodes.assign(nrNodes, 0);
+    counts.assign(counts.size(), 0.0); // outputs are 0 if updates is 0
+    for (int u = 0; u < updates; u++) {
+      std::copy(laneInputs.begin(), laneInputs.end(), laneNodes.begin());
+      packedGates.updateLanes(laneNodes.data(), nextLaneNodes.data(),
+                              u == updates - 1 ? counts.data() : nullptr,
+                              laneMask);
+      swap(laneNodes, nextLaneNodes);
+    }
+
+    for (int l = 0; l < lanes; l++)
+      outputs[first + l].assign(counts.begin() + l * nrOutputValues,
+                                counts.begin() + (l + 1) * nrOutputValues);
+  }
+}
+
 void MarkovBrain::update() {
+  if (!cacheUpdates) {
+    runUpdate();
+    return;
+  }
+
+  // the first value keeps bit packed and unpacked keys apart
+  cacheKey.clear();
+  if (binaryNodes) {
+    cacheKey.push_back(1.0);
+    for (size_t w = 0; w < nodeBits.size(); w++) {
+      uint64_t word = nodeBits[w];
+      for (int i = 64 * w; i < nrInputValues && i < 64 * (int)(w + 1); i++)
+        word &= ~(uint64_t(1) << (i % 64)); // inputs are about to be replaced
+      cacheKey.push_back(double(word & 0xffffffff));
+      cacheKey.push_back(double(word >> 32));
+    }
+    for (int i = 0; i < nrInputValues; i++)
+      cacheKey.push_back(inputValues[i] > 0.0);
+  } else {
+    cacheKey.push_back(0.0);
+    for (int i = 0; i < nrInputValues; i++)
+      cacheKey.push_back(Bit(inputValues[i]));
+    for (int i = nrInputValues; i < nrNodes; i++)
+      cacheKey.push_back(Bit(nodes[i]));
+  }
+
+  // the result is the node state after the update (and outputs if packed)
+  if (auto cached = updateCache.find(cacheKey)) {
+    if (binaryNodes) {
+      for (size_t w = 0; w < nodeBits.size(); w++)
+        nodeBits[w] = uint64_t((*cached)[2 * w]) |
+                      (uint64_t((*cached)[2 * w + 1]) << 32);
+      std::copy(cached->begin() + 2 * nodeBits.size(), cached->end(),
+                outputValues.begin());
+    } else {
+      nodes = *cached;
+      for (int i = 0; i < nrOutputValues; i++)
+        outputValues[i] = nodes[nrInputValues + i];
+    }
+    return;
+  }
+
+  runUpdate();
+  if (binaryNodes) {
+    cacheResult.clear();
+    for (auto word : nodeBits) {
+      cacheResult.push_back(double(word & 0xffffffff));
+      cacheResult.push_back(double(word >> 32));
+    }
+    cacheResult.insert(cacheResult.end(), outputValues.begin(),
+                       outputValues.end());
+    updateCache.store(cacheKey, cacheResult);
+  } else {
+    updateCache.store(cacheKey, nodes);
+  }
+}
+
+void MarkovBrain::runUpdate() {
+  if (binaryNodes) {
+    for (int i = 0; i < nrInputValues; i++) {
+      uint64_t bit = uint64_t(1) << (i % 64);
+      if (inputValues[i] > 0.0)
+        nodeBits[i / 64] |= bit;
+      else
+        nodeBits[i / 64] &= ~bit;
+    }
+    packedGates.update(nodeBits.data(), nextNodeBits.data(),
+                       outputValues.data());
+    swap(nodeBits, nextNodeBits);
+    return;
+  }
+
   nextNodes.assign(nrNodes, 0.0);
 	DataMap IOMap;
 
   for (int i = 0; i < nrInputValues; i++)  
     nodes[i] = inputValues[i];
   
-  if (recordIOMapPL->get())
+  if (recordIOMap)
     for (int i = 0; i < nrInputValues; i++)
      IOMap.append("input", Bit(nodes[i]));
 
-  for (auto &g :gates) // update each gate
-	  g->update(nodes, nextNodes);
+  if (compileGates)
+    compiledGates.update(nodes, nextNodes);
+  else
+    for (auto &g :gates) // update each gate
+	    g->update(nodes, nextNodes);
 
   if (randomizeUnconnectedOutputs) {
     switch (randomizeUnconnectedOutputsType) {
@@ -192,7 +404,7 @@ void MarkovBrain::update() {
     outputValues[i] = nodes[nrInputValues + i];
   }
 
-  if (recordIOMapPL->get()){
+  if (recordIOMap){
    for (int i = 0; i < nrOutputValues; i++ )
       IOMap.append("output", Bit(nodes[nrInputValues + i]));
 	
@@ -206,10 +418,11 @@ void MarkovBrain::update() {
   }
 }
 
-void MarkovBrain::inOutReMap() { // remaps genome site values to valid brain
-                                 // state addresses
-  for (auto &g : gates)
-    g->applyNodeMap(nodeMap, nrNodes);
+void MarkovBrain::inOutReMap(const std::vector<bool> &reused) {
+  // remaps genome site values to valid brain state addresses
+  for (size_t i = 0; i < gates.size(); i++)
+    if (i >= reused.size() || !reused[i])
+      gates[i]->applyNodeMap(nodeMap, nrNodes);
 }
 
 std::string MarkovBrain::description() {
@@ -288,6 +501,7 @@ int MarkovBrain::numGates() { return brainSize(); }
 
 std::vector<int> MarkovBrain::getHiddenNodes() {
   std::vector<int> temp ;
+  unpackNodes();
   for (size_t i = nrInputValues + nrOutputValues; i < nodes.size(); i++) 
     temp.push_back(Bit(nodes[i]));
   
@@ -16,6 +16,7 @@
 #include <set>
 #include <vector>
 
+#include "CompiledGates/CompiledGates.h"
 #include "GateListBuilder/GateListBuilder.h"
 #include "../../Genome/AbstractGenome.h"
 
@@ -34,6 +35,8 @@ public:
 
   static std::shared_ptr<ParameterLink<bool>> randomizeUnconnectedOutputsPL;
   static std::shared_ptr<ParameterLink<bool>> recordIOMapPL;
+  static std::shared_ptr<ParameterLink<bool>> compileGatesPL;
+  static std::shared_ptr<ParameterLink<bool>> reuseGatesPL;
   static std::shared_ptr<ParameterLink<std::string>> IOMapFileNamePL;
   static std::shared_ptr<ParameterLink<int>> randomizeUnconnectedOutputsTypePL;
   static std::shared_ptr<ParameterLink<double>>
@@ -49,6 +52,33 @@ public:
   double randomizeUnconnectedOutputsMax;
   int hiddenNodes;
   std::string genomeName;
+  bool recordIOMap;
+  bool compileGates;
+  bool reuseGates;
+
+  // where gates were read from in the genome (if reuseGates), so that
+  // offspring can copy gates from the parts of the genome they did not mutate
+  GateSites gateSites;
+
+  // gates lowered into flat arrays (used by update() if compileGates)
+  CompiledGates compiledGates;
+
+  // if compileGates and every gate is Deterministic, node state is kept bit
+  // packed in nodeBits and update() uses packedGates. nodes is then only
+  // filled in when asked for (see unpackNodes()).
+  bool binaryNodes = false;
+  PackedGates packedGates;
+  std::vector<uint64_t> nodeBits, nextNodeBits;
+
+  // copy nodeBits into nodes (0.0 or 1.0) and back
+  void unpackNodes();
+  void packNodes();
+
+  // if updateCache is on and every gate is Deterministic, update() looks up
+  // the node state it is about to compute in updateCache before running it
+  bool cacheUpdates = false;
+  std::vector<double> cacheKey, cacheResult;
+  void runUpdate();
 
   std::vector<double> nodes;
   std::vector<double> nextNodes;
@@ -87,10 +117,12 @@ public:
               int _nrOutNodes, std::shared_ptr<ParametersTable> PT_ = nullptr);
   MarkovBrain(std::shared_ptr<AbstractGateListBuilder> GLB_, int _nrInNodes,
               int _nrOutNodes, std::shared_ptr<ParametersTable> PT_ = nullptr);
+  // if parent is given, gates may be copied from it (see reuseGates)
   MarkovBrain(std::shared_ptr<AbstractGateListBuilder> GLB_,
               std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes,
               int _nrInNodes, int _nrOutNodes,
-              std::shared_ptr<ParametersTable> PT_ = nullptr);
+              std::shared_ptr<ParametersTable> PT_ = nullptr,
+              const MarkovBrain *parent = nullptr);
 
   virtual ~MarkovBrain() = default;
 
@@ -99,14 +131,29 @@ public:
 
   void readParameters();
 
+  // rebuild compiledGates from gates. must be called if gates is changed.
+  void compile();
+
   virtual void update() override;
+  // with bit packed nodes, runs 64 lanes at a time (see PackedGates)
+  virtual void updateBatch(const std::vector<std::vector<double>> &inputs,
+                           std::vector<std::vector<double>> &outputs,
+                           int updates = 1) override;
 
-  void inOutReMap();
+  // map genome values in gates to node addresses, skipping gates marked in
+  // reused (which were copied from a brain where this was already done)
+  void inOutReMap(const std::vector<bool> &reused = {});
 
   // Make a brain like the brain that called this function, using genomes and
   // initalizing other elements.
   virtual std::shared_ptr<AbstractBrain> makeBrain(
       std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) override;
+  virtual std::shared_ptr<AbstractBrain> makeBrainFrom(
+      std::shared_ptr<AbstractBrain> parent,
+      std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) override;
+  virtual std::shared_ptr<AbstractBrain> makeBrainFromMany(
+      std::vector<std::shared_ptr<AbstractBrain>> parents,
+      std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) override;
 
   virtual std::string description() override;
   void fillInConnectionsLists();
@@ -138,6 +185,9 @@ public:
     bool fbState=DecomposableFeedbackGate::feedbackON;
     int maxReps=1000;//100;
     cout << maxReps << endl;
+    unpackNodes(); // work on nodes (not nodeBits)
+    bool useBinaryNodes=binaryNodes;
+    binaryNodes=false;
     vector<double> recoverState=nodes;
     vector<double> recoverNextNodeStates=nextNodes;
     vector<double> recoverI=inputValues;
@@ -170,6 +220,8 @@ public:
     inputValues=recoverI;
     outputValues=recoverO;
     DecomposableFeedbackGate::feedbackON=fbState;
+    binaryNodes=useBinaryNodes;
+    packNodes();
     return TPM;
   }
   
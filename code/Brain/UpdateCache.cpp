@@ -0,0 +1,72 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "UpdateCache.h"
+
+#include <functional>
+
+size_t UpdateCache::KeyHash::operator()(const std::vector<double> &key) const {
+  size_t hash = key.size();
+  for (auto v : key) {
+    hash ^= std::hash<double>()(v) + 0x9e3779b97f4a7c15ULL + (hash << 6) +
+            (hash >> 2);
+  }
+  return hash;
+}
+
+UpdateCache::UpdateCache(const UpdateCache &other)
+    : hits(other.hits), misses(other.misses), capacity(other.capacity),
+      threshold(other.threshold), entries(other.entries) {
+  for (auto entry = entries.begin(); entry != entries.end(); ++entry) {
+    lookup[entry->key] = entry;
+  }
+}
+
+UpdateCache &UpdateCache::operator=(const UpdateCache &other) {
+  if (this != &other) {
+    *this = UpdateCache(other);
+  }
+  return *this;
+}
+
+const std::vector<double> *UpdateCache::find(const std::vector<double> &key) {
+  auto found = lookup.find(key);
+  if (found == lookup.end() || found->second->runs < threshold) {
+    misses++;
+    return nullptr;
+  }
+  hits++;
+  entries.splice(entries.begin(), entries, found->second);
+  return &found->second->result;
+}
+
+void UpdateCache::store(const std::vector<double> &key,
+                        const std::vector<double> &result) {
+  auto found = lookup.find(key);
+  if (found != lookup.end()) {
+    // seen before but not run enough times yet, keep the first result
+    found->second->runs++;
+    entries.splice(entries.begin(), entries, found->second);
+    return;
+  }
+  if ((int)entries.size() >= capacity) {
+    lookup.erase(entries.back().key);
+    entries.pop_back();
+  }
+  entries.push_front({key, result, 1});
+  lookup[key] = entries.begin();
+}
+
+void UpdateCache::clear() {
+  entries.clear();
+  lookup.clear();
+  hits = 0;
+  misses = 0;
+}
@@ -0,0 +1,73 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// A bounded memo of brain updates. A brain whose update() depends only on its
+// inputs and its own state can describe both as a key, and the state (and
+// outputs) after the update as a result. When the same key comes up again the
+// result can be loaded instead of running the update.
+//
+// At most capacity results are kept, when full the least recently used result
+// is dropped. A result is only reused once its key has been run threshold
+// times (1 = reuse the first result).
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+class UpdateCache {
+public:
+  UpdateCache(int _capacity = 0, int _threshold = 1)
+      : capacity(_capacity), threshold(_threshold) {}
+
+  // lookup holds iterators into entries, so a copy rebuilds it (moving a
+  // std::list keeps its iterators valid)
+  UpdateCache(const UpdateCache &other);
+  UpdateCache &operator=(const UpdateCache &other);
+  UpdateCache(UpdateCache &&) = default;
+  UpdateCache &operator=(UpdateCache &&) = default;
+
+  // an empty cache with the same capacity and threshold
+  UpdateCache emptyCopy() const { return UpdateCache(capacity, threshold); }
+
+  bool enabled() const { return capacity > 0; }
+
+  // the result stored for key, or nullptr if key has not been run at least
+  // threshold times. counts a hit or a miss.
+  const std::vector<double> *find(const std::vector<double> &key);
+
+  // call after running an update that find() missed on
+  void store(const std::vector<double> &key,
+             const std::vector<double> &result);
+
+  void clear();
+
+  int hits = 0;
+  int misses = 0;
+
+private:
+  struct KeyHash {
+    size_t operator()(const std::vector<double> &key) const;
+  };
+  struct Entry {
+    std::vector<double> key;
+    std::vector<double> result;
+    int runs;
+  };
+
+  int capacity;
+  int threshold;
+  // most recently used first
+  std::list<Entry> entries;
+  std::unordered_map<std::vector<double>, std::list<Entry>::iterator, KeyHash>
+      lookup;
+};
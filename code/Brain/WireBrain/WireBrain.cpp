@@ -50,13 +50,13 @@ std::shared_ptr<ParameterLink<bool>> WireBrain::cacheResultsPL =
     Parameters::register_parameter("BRAIN_WIRE-cacheResults", false,
                                    "if true, t+1 nodes will be cached. If the "
                                    "same input is seen, the cached node values "
-                                   "will be used.");
+                                   "will be used. (same as setting "
+                                   "BRAIN-updateCacheSize, which wins if set)");
 std::shared_ptr<ParameterLink<int>> WireBrain::cacheResultsCountPL =
     Parameters::register_parameter("BRAIN_WIRE-cacheResultsCount", 1,
-                                   "input combinations will be cached this "
-                                   "many times, after this, repeats of a given "
-                                   "input array will look up a random value "
-                                   "from cached values");
+                                   "with cacheResults, an input combination "
+                                   "must be run this many times before the "
+                                   "cached value is used");
 
 std::shared_ptr<ParameterLink<std::string>> WireBrain::genomeDecodingMethodPL =
     Parameters::register_parameter(
@@ -751,23 +751,12 @@ std::shared_ptr<AbstractBrain> WireBrain::makeBrain(
 
 void WireBrain::initialize() {
   allCells.resize(width * depth * height);
-  nextAllCells.resize(width * depth * height);
   neighbors.resize(width * depth * height);
 
   nodesAddresses.resize(nrValues);
   nodesNextAddresses.resize(nrValues);
 
   if (cacheResults) {
-    inputLookUpTable.resize((int)pow(2, nrValues)); // set lookup tables to be
-                                                    // large enough to handle
-                                                    // all possible input
-                                                    // combinations
-    inputCount.clear(); // insure that the input counts are all 0.
-    inputCount.resize((int)pow(2, nrValues));
-    for (int i = 0; i < pow(2, nrValues); i++) {
-      inputCount[i] = 0;
-    }
-
     if (cacheResultsCount < 1) {
       std::cout << "\n\nERROR! in WireBrain(std::shared_ptr<AbstractGenome> "
                    "genome, int _nrOfNodes) cacheResultsCount must be > "
@@ -775,7 +764,13 @@ void WireBrain::initialize() {
                 << std::endl;
       exit(1);
     }
+    // BRAIN_WIRE-cacheResults predates BRAIN-updateCacheSize, so it only
+    // turns the cache on when updateCacheSize has not
+    if (!updateCache.enabled()) {
+      updateCache = UpdateCache(defaultCacheSize, cacheResultsCount);
+    }
   }
+  cacheKey.resize(nrValues);
   // establish I/O
   if ((width * depth * height) < (nrValues * worldConnectionsSeparation)) {
     std::cout << "ERROR: WireBrain requires a bigger brain width * depth * "
@@ -1050,6 +1045,7 @@ void WireBrain::connectPruneAndSetPopColumns(
     newAllCells[w] = 1;
   }
   swap(newAllCells, allCells);
+  buildWireGraph();
 
   // displayBrainState();
 
@@ -1062,54 +1058,115 @@ void WireBrain::connectPruneAndSetPopColumns(
   popFileColumns.push_back("wireBrainConnectionsCount");
 }
 
+void WireBrain::buildWireGraph() {
+  int cellCount = (int)allCells.size();
+  std::vector<char> isWire(cellCount, 0);
+  for (auto w : wireAddresses) {
+    isWire[w] = 1;
+  }
+
+  // count, then fill, the in and out lists for every wire cell
+  inStarts.assign(cellCount + 1, 0);
+  outStarts.assign(cellCount + 1, 0);
+  for (int c = 0; c < cellCount; c++) {
+    if (isWire[c]) {
+      inStarts[c + 1] = (int)neighbors[c].size();
+      for (auto n : neighbors[c]) {
+        outStarts[n + 1]++;
+      }
+    }
+  }
+  for (int c = 0; c < cellCount; c++) {
+    inStarts[c + 1] += inStarts[c];
+    outStarts[c + 1] += outStarts[c];
+  }
+  inCells.resize(inStarts[cellCount]);
+  outCells.resize(outStarts[cellCount]);
+  std::vector<int> outFill(outStarts.begin(), outStarts.end() - 1);
+  for (int c = 0; c < cellCount; c++) {
+    if (isWire[c]) {
+      std::copy(neighbors[c].begin(), neighbors[c].end(),
+                inCells.begin() + inStarts[c]);
+      for (auto n : neighbors[c]) {
+        outCells[outFill[n]++] = c;
+      }
+    }
+  }
+
+  activeCells.clear();
+  isActive.assign(cellCount, 0);
+  isCandidate.assign(cellCount, 0);
+  for (int c = 0; c < cellCount; c++) {
+    if (isWire[c] && allCells[c] != WIRE) {
+      isActive[c] = 1;
+      activeCells.push_back(c);
+    }
+  }
+}
+
+void WireBrain::setCell(int cell, int value) {
+  allCells[cell] = value;
+  if (value != WIRE && !isActive[cell]) {
+    isActive[cell] = 1;
+    activeCells.push_back(cell);
+  }
+}
+
+void WireBrain::clearCharges() {
+  for (auto cell : activeCells) {
+    allCells[cell] = WIRE;
+    isActive[cell] = 0;
+  }
+  activeCells.clear();
+}
+
 void WireBrain::chargeUpdate() {
-  // std::cout << "in chargeUpdate()" << endl;
-  // int wireCount = 0;
-  // int evalCount = 0;
-  // int evalToCharge = 0;
-  // int evalToDecay = 0;
-  // int evalToWire = 0;
-
-  nextAllCells = allCells;
-
-  // propagate charge in the brain
-  int chargeCount;
-  for (auto cellAddress : wireAddresses) {
-    // wireCount++;
-    if (allCells[cellAddress] == WIRE) {
-      chargeCount = 0;
-      int nc = (int)neighbors[cellAddress].size() -
-               1; // get the number of neighbors which are wire
-      while (nc >= 0 &&
-             chargeCount < overchargeThreshold) { // for each neighbor
-        if (allCells[neighbors[cellAddress][nc]] ==
-            CHARGE) { // if that neighbor is charged
-          chargeCount++;
-          nextAllCells[cellAddress] = CHARGE; // set this WIRE to CHARGE
+  // work out all changes from the current state before changing anything.
+  // charged and decaying cells decay, WIRE cells next to charged cells may
+  // become charged, nothing else can change.
+  cellChanges.clear();
+  candidateCells.clear();
+  for (auto cell : activeCells) {
+    if (allCells[cell] == WIRE) {
+      continue;
+    }
+    cellChanges.push_back({cell, allCells[cell] - 1});
+    if (allCells[cell] == CHARGE) {
+      for (int o = outStarts[cell]; o < outStarts[cell + 1]; o++) {
+        int next = outCells[o];
+        if (allCells[next] == WIRE && !isCandidate[next]) {
+          isCandidate[next] = 1;
+          candidateCells.push_back(next);
         }
-        nc--;
       }
-      if (chargeCount >= overchargeThreshold) {
-        nextAllCells[cellAddress] = WIRE; // if overcharged, change back to WIRE
-        // evalToCharge++;
+    }
+  }
+  for (auto cell : candidateCells) {
+    isCandidate[cell] = 0;
+    int chargeCount = 0;
+    for (int n = inStarts[cell];
+         n < inStarts[cell + 1] && chargeCount < overchargeThreshold; n++) {
+      if (allCells[inCells[n]] == CHARGE) { // if that neighbor is charged
+        chargeCount++;
       }
-      // std::cout << "  " << cellAddress << " " << nextAllCells[cellAddress] <<
-      // endl;
-    } else { // this wire is currently either charged or in decay
-      nextAllCells[cellAddress] = allCells[cellAddress] - 1;
     }
+    // if overcharged, stay WIRE
+    if (chargeCount > 0 && chargeCount < overchargeThreshold) {
+      cellChanges.push_back({cell, CHARGE});
+    }
+  }
+  clearCharges();
+  for (auto &change : cellChanges) {
+    setCell(change.first, change.second);
   }
-  allCells = nextAllCells;
 
   // if constantInputs, rechage the inputs
   if (constantInputs) {
     for (int i = 0; i < nrValues; i++) { // for each input cell
-      // evalCount++;
       if (nodes[i] != 0) { // if this node is on
         if (allCells[nodesAddresses[i]] !=
             HOLLOW) { // if the connected location is uncharged wireAddresses...
-          allCells[nodesAddresses[i]] = CHARGE * Bit(nodes[i]); // charge it.
-          // evalToCharge++;
+          setCell(nodesAddresses[i], CHARGE * Bit(nodes[i])); // charge it.
         }
       }
     }
@@ -1122,79 +1179,58 @@ void WireBrain::chargeUpdate() {
 }
 
 void WireBrain::chargeUpdateTrit() {
-  // std::cout << "in chargeUpdate()" << endl;
-  // int wireCount = 0;
-  // int evalCount = 0;
-  // int evalToCharge = 0;
-  // int evalToDecay = 0;
-  // int evalToWire = 0;
-
-  nextAllCells = allCells;
-
-  // propagate charge in the brain
-  int chargeCount;
-  for (auto cellAddress : wireAddresses) {
-    // wireCount++;
-    nextAllCells[cellAddress] = 1;
-    if (allCells[cellAddress] == WIRE) {
-      chargeCount = 0;
-      //				int nc = (int)
-      //neighbors[cellAddress].size() - 1;  // get the number of neighbors which
-      //are wire
-      //				while (nc >= 0) {  // for each neighbor
-      //					if
-      //(allCells[neighbors[cellAddress][nc]] == CHARGE) {  // if that neighbor
-      //is charged
-      //						chargeCount++;
-      //						//nextAllCells[cellAddress]
-      //= CHARGE;  // set this WIRE to CHARGE
-      //					}
-      //					if
-      //(allCells[neighbors[cellAddress][nc]] == NEGCHARGE) {  // if that
-      //neighbor is charged
-      //						chargeCount--;
-      //						//nextAllCells[cellAddress]
-      //= CHARGE;  // set this WIRE to CHARGE
-      //					}
-      //					nc--;
-      //				}
-
-      for (auto n : neighbors[cellAddress]) {
-        if (allCells[n] == CHARGE) { // if that neighbor is charged
-          chargeCount++;
-          // nextAllCells[cellAddress] = CHARGE;  // set this WIRE to CHARGE
-        }
-        if (allCells[n] == NEGCHARGE) { // if that neighbor is charged
-          chargeCount--;
-          // nextAllCells[cellAddress] = CHARGE;  // set this WIRE to CHARGE
+  // as chargeUpdate(), but negative charge is also spread and a neighbors
+  // negative charge cancels out a positive one
+  cellChanges.clear();
+  candidateCells.clear();
+  for (auto cell : activeCells) {
+    if (allCells[cell] == WIRE) {
+      continue;
+    }
+    if (allCells[cell] == NEGCHARGE) {
+      cellChanges.push_back({cell, CHARGE - 1});
+    } else { // this wire is currently either charged or in decay
+      cellChanges.push_back({cell, allCells[cell] - 1});
+    }
+    if (allCells[cell] == CHARGE || allCells[cell] == NEGCHARGE) {
+      for (int o = outStarts[cell]; o < outStarts[cell + 1]; o++) {
+        int next = outCells[o];
+        if (allCells[next] == WIRE && !isCandidate[next]) {
+          isCandidate[next] = 1;
+          candidateCells.push_back(next);
         }
       }
-      if (chargeCount > 0 && chargeCount < overchargeThreshold) {
-        nextAllCells[cellAddress] =
-            CHARGE; // if overcharged, change back to WIRE
-        // evalToCharge++;
-      } else if (chargeCount < 0 && chargeCount > (overchargeThreshold * -1)) {
-        nextAllCells[cellAddress] = NEGCHARGE;
+    }
+  }
+  for (auto cell : candidateCells) {
+    isCandidate[cell] = 0;
+    int chargeCount = 0;
+    for (int n = inStarts[cell]; n < inStarts[cell + 1]; n++) {
+      if (allCells[inCells[n]] == CHARGE) { // if that neighbor is charged
+        chargeCount++;
       }
-      // std::cout << "  " << cellAddress << " " << nextAllCells[cellAddress] <<
-      // endl;
-    } else if (allCells[cellAddress] == NEGCHARGE) {
-      nextAllCells[cellAddress] = CHARGE - 1;
-    } else { // this wire is currently either charged or in decay
-      nextAllCells[cellAddress] = allCells[cellAddress] - 1;
+      if (allCells[inCells[n]] == NEGCHARGE) { // if that neighbor is charged
+        chargeCount--;
+      }
+    }
+    if (chargeCount > 0 && chargeCount < overchargeThreshold) {
+      cellChanges.push_back({cell, CHARGE});
+    } else if (chargeCount < 0 && chargeCount > (overchargeThreshold * -1)) {
+      cellChanges.push_back({cell, NEGCHARGE});
     }
   }
-  allCells = nextAllCells;
+  clearCharges();
+  for (auto &change : cellChanges) {
+    setCell(change.first, change.second);
+  }
 
   // if constantInputs, rechage the inputs
   if (constantInputs) {
     for (int i = 0; i < nrValues; i++) { // for each input cell
-      // evalCount++;
       if (nodes[i] != 0) { // if this node is on
         if (allCells[nodesAddresses[i]] !=
             HOLLOW) { // if the connected location is uncharged wireAddresses...
-          allCells[nodesAddresses[i]] = CHARGE * Trit(nodes[i]); // charge it.
-          // evalToCharge++;
+          setCell(nodesAddresses[i], CHARGE * Trit(nodes[i])); // charge it.
         }
       }
     }
@@ -1202,165 +1238,65 @@ void WireBrain::chargeUpdateTrit() {
   // read and accumulate outputs
   // NOTE: output cells can go into charge/decay sets
   for (int i = 0; i < nrValues; i++) {
-    // std::cout << i << " " << nodesNextAddresses[i] << " " << nodesNext[i]
-    // <<endl;
     nextNodes[i] = nextNodes[i] + allCells[nodesNextAddresses[i]];
-    // std::cout << i << " " << nodesNextAddresses[i] << " " << nodesNext[i]
-    // <<endl;
   }
 }
 
-void WireBrain::update() {
-
-  for (int i = 0; i < nrInputValues; i++) {
-    nodes[i] = inputValues[i];
-  }
-
-  // std::cout << "in update()"<<endl;
-
-  /// first see if we we already know this input
-
-  //		for (auto v:inputCount){
-  //			if (v != 0){
-  //				std::cout << "found: " << v << endl;
-  //				exit(1);
-  //			}
-  //		}
-
-  if (cacheResults) {
-    long inputLookUpValue = 0;
-    // std::cout << "\nInput nodes: ";
-
-    for (int i = 0; i < nrValues; i++) { // load inputs into inputLookUpValue
-      inputLookUpValue = Bit(nodes[i]) + (inputLookUpValue << 1);
-      // std::cout << nodes[i];
-    }
-    // std::cout << " = " << inputLookUpValue << endl << "  count: " <<
-    // inputCount[inputLookUpValue] << endl;
-    if (inputCount[inputLookUpValue] >=
-        cacheResultsCount) { // if we have seen this value at least
-                             // cacheResultsCount
-      // long outputValue =
-      // inputLookUpTable[inputLookUpValue][Random::getIndex(cacheResultsCount)];
-      // // pull a stored value randomly
-      long outputValue =
-          inputLookUpTable[inputLookUpValue][0]; // pull a stored value randomly
-      // std::cout << " outputValue: " << outputValue << " = ";
-      for (int i = nrValues - 1; i > -1;
-           i--) {                       // load outputValue into nodesNext
-        nextNodes[i] = outputValue & 1; // get right most bit
-        outputValue = outputValue >> 1; // clip off right most bit
-        // std::cout << nodesNext[i];
-      }
-      // std::cout << endl;
-    } else { // we have not seen this input value enough times, and we will need
-             // to actually do the work
-      for (auto w : wireAddresses) { // clear out any wire that is charged or
-                                     // decay from last update
-        allCells[w] = 1;
+void WireBrain::runCharges() {
+  // clear out any wire that is charged or decay from last update
+  clearCharges();
+  for (int i = 0; i < nrValues; i++) { // set up inputs and outputs
+    nextNodes[i] = 0;                  // reset all nodesNext
+    if (!allowNegativeCharge) {
+      if (Bit(nodes[i]) == 1 &&
+          allCells[nodesAddresses[i]] ==
+              WIRE) { // for each node if it is on and connects to wire
+        setCell(nodesAddresses[i], CHARGE); // charge the wire
       }
-      for (int i = 0; i < nrValues; i++) { // set up inputs and outputs
-        nextNodes[i] = 0;                  // reset all nodesNext
-        if (!allowNegativeCharge) {
-          if (Bit(nodes[i]) == 1 &&
-              allCells[nodesAddresses[i]] ==
-                  WIRE) { // for each node if it is on and connects to wire
-            allCells[nodesAddresses[i]] = CHARGE; // charge the wire
-          }
-        } else {
-          if (Trit(nodes[i]) != 0 &&
-              allCells[nodesAddresses[i]] ==
-                  WIRE) { // for each node if it is on and connects to wire
-            allCells[nodesAddresses[i]] =
-                CHARGE * Trit(nodes[i]); // charge the wire
-          }
-        }
-        //// for testing only!!!////
-        // allCells[0]=CHARGE;
-        /////////////////////////////
-      }
-      if (recordActivity) {
-        SaveBrainState("wireBrain.run");
-      }
-      for (int count = 0; count < chargeUpdatesPerUpdate; count++) {
-        if (!allowNegativeCharge) {
-          chargeUpdate();
-        } else {
-          chargeUpdateTrit();
-        }
-        if (recordActivity) {
-          SaveBrainState(recordActivityFileName);
-        }
-      }
-      //////
-      // set lookup table value!
-      //////
-      long outputValue = 0;
-      for (int i = 0; i < nrValues; i++) { // load outputs into outputValue
-        outputValue = (long)Bit(nextNodes[i]) + (outputValue << 1);
+    } else {
+      if (Trit(nodes[i]) != 0 &&
+          allCells[nodesAddresses[i]] ==
+              WIRE) { // for each node if it is on and connects to wire
+        setCell(nodesAddresses[i],
+                CHARGE * Trit(nodes[i])); // charge the wire
       }
-      inputLookUpTable[inputLookUpValue].push_back(
-          outputValue); // push outputValue into the lookup table
     }
-    inputCount[inputLookUpValue]++;
-
-  } else { // no caching
-    /*
-    for (auto w : wireAddresses) {  // clear out anything that is charged or
-    decay from last update
-            allCells[w] = 1;
+  }
+  if (recordActivity) {
+    SaveBrainState("wireBrain.run");
+  }
+  for (int count = 0; count < chargeUpdatesPerUpdate; count++) {
+    if (!allowNegativeCharge) {
+      chargeUpdate();
+    } else {
+      chargeUpdateTrit();
+    }
+    if (recordActivity) {
+      SaveBrainState(recordActivityFileName);
     }
+  }
+}
 
+void WireBrain::update() {
 
-    for (int i = 0; i < nrValues; i++) {  // set up inputs and outputs
-            nextNodes[i] = 0;  // reset nodesNext
-            if (Bit(nodes[i]) == 1 && allCells[nodesAddresses[i]] == WIRE) {  //
-    if this node is on and connects to wire
-                    allCells[nodesAddresses[i]] = CHARGE;
-            }
-    }
+  for (int i = 0; i < nrInputValues; i++) {
+    nodes[i] = inputValues[i];
+  }
 
-    for (int count = 0; count < chargeUpdatesPerUpdate; count++) {
-            chargeUpdate();
-    }
-    */
-    for (auto w : wireAddresses) { // clear out any wire that is charged or
-                                   // decay from last update
-      allCells[w] = 1;
+  // the charges only see the sign of each node, so that is the key.
+  // when recording activity always run the charges so they get saved
+  if (updateCache.enabled() && !recordActivity) {
+    for (int i = 0; i < nrValues; i++) {
+      cacheKey[i] = Trit(nodes[i]);
     }
-    for (int i = 0; i < nrValues; i++) { // set up inputs and outputs
-      nextNodes[i] = 0;                  // reset all nodesNext
-      if (!allowNegativeCharge) {
-        if (Bit(nodes[i]) == 1 &&
-            allCells[nodesAddresses[i]] ==
-                WIRE) { // for each node if it is on and connects to wire
-          allCells[nodesAddresses[i]] = CHARGE; // charge the wire
-        }
-      } else {
-        if (Trit(nodes[i]) != 0 &&
-            allCells[nodesAddresses[i]] ==
-                WIRE) { // for each node if it is on and connects to wire
-          allCells[nodesAddresses[i]] =
-              CHARGE * Trit(nodes[i]); // charge the wire
-        }
-      }
-      //// for testing only!!!////
-      // allCells[0]=CHARGE;
-      /////////////////////////////
-    }
-    if (recordActivity) {
-      SaveBrainState("wireBrain.run");
-    }
-    for (int count = 0; count < chargeUpdatesPerUpdate; count++) {
-      if (!allowNegativeCharge) {
-        chargeUpdate();
-      } else {
-        chargeUpdateTrit();
-      }
-      if (recordActivity) {
-        SaveBrainState(recordActivityFileName);
-      }
+    if (auto cached = updateCache.find(cacheKey)) {
+      nextNodes = *cached;
+    } else {
+      runCharges();
+      updateCache.store(cacheKey, nextNodes);
     }
+  } else {
+    runCharges();
   }
 
   swap(nodes, nextNodes);
@@ -1536,8 +1472,9 @@ WireBrain::makeCopy(std::shared_ptr<ParametersTable> PT_) {
   newBrain->allCells = allCells;
   newBrain->wireAddresses = wireAddresses;
   newBrain->neighbors = neighbors;
-  newBrain->inputLookUpTable = inputLookUpTable;
-  newBrain->inputCount = inputCount;
+  newBrain->buildWireGraph();
+  newBrain->updateCache = updateCache.emptyCopy();
+  newBrain->cacheKey = cacheKey;
   newBrain->connectionsCount = connectionsCount;
 
   newBrain->nrValues = nrValues;
@@ -117,17 +117,30 @@ public:
   std::vector<int> nodesAddresses,
       nodesNextAddresses; // where the nodes connect to the brain
 
-  std::vector<int> allCells, nextAllCells; // list of all cells in this brain
+  std::vector<int> allCells; // list of all cells in this brain
   std::vector<std::vector<int>>
       neighbors; // for every cell list of wired neighbors (most will be empty)
   std::vector<int> wireAddresses; // list of addresses for all cells which are
                                   // wireAddresses (uncharged, charged and
                                   // decay)
 
-  std::vector<std::vector<long>>
-      inputLookUpTable;        // table that contains output for a given input
-  std::vector<int> inputCount; // table that contains a count of the number of
-                               // times we have seen a given input
+  // neighbors of wire cells in compressed sparse row form (see
+  // buildWireGraph()). charge flows into cell c from inCells[inStarts[c]] to
+  // inCells[inStarts[c + 1] - 1] and out to outCells[outStarts[c]] to
+  // outCells[outStarts[c + 1] - 1]
+  std::vector<int> inStarts, inCells, outStarts, outCells;
+
+  // wire cells which are not WIRE (i.e. charged or in decay). on a charge
+  // update only these cells and WIRE cells next to charged cells can change,
+  // so this is all that chargeUpdate() looks at
+  std::vector<int> activeCells;
+  std::vector<char> isActive, isCandidate;
+  std::vector<int> candidateCells;
+  std::vector<std::pair<int, int>> cellChanges; // (cell, new value)
+
+  // updateCache capacity used when only BRAIN_WIRE-cacheResults is set
+  static const int defaultCacheSize = 100000;
+  std::vector<double> cacheKey;
 
   static std::shared_ptr<ParameterLink<std::string>> genomeNamePL;
   std::string genomeName;
@@ -155,6 +168,12 @@ public:
   virtual std::shared_ptr<AbstractBrain>
   makeCopy(std::shared_ptr<ParametersTable> PT_ = nullptr) override;
 
+  virtual void buildWireGraph();
+  // set allCells[cell] to value, adding the cell to activeCells if needed
+  void setCell(int cell, int value);
+  // set all charged and decaying wire back to WIRE
+  void runCharges(); // compute nextNodes from nodes
+  void clearCharges();
   virtual void chargeUpdate();
   virtual void chargeUpdateTrit();
   virtual void update() override;
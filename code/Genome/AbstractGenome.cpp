@@ -27,4 +27,10 @@ std::shared_ptr<ParameterLink<std::string>> AbstractGenome::genomeSitesTypePL =
         "type for sites in genome [char, int, double, bool]"); // string
                                                                // parameter for
                                                                // outputMethod;
+std::shared_ptr<ParameterLink<bool>> AbstractGenome::serializeBinaryPL =
+    Parameters::register_parameter(
+        "GENOME-serializeBinary", false,
+        "if true, genome sites are saved to organism files in a compact "
+        "binary (base64) form instead of as comma separated values. Either "
+        "form can be loaded");
 
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <memory>
 #include <vector>
 
 #include <fstream>
@@ -29,6 +30,7 @@ public:
   static std::shared_ptr<ParameterLink<std::string>> genomeTypeStrPL;
   static std::shared_ptr<ParameterLink<double>> alphabetSizePL;
   static std::shared_ptr<ParameterLink<std::string>> genomeSitesTypePL;
+  static std::shared_ptr<ParameterLink<bool>> serializeBinaryPL;
 
   const std::shared_ptr<ParametersTable> PT;
 
@@ -123,6 +125,9 @@ public:
     virtual bool inTelomere(int length) { return false; }
 
     virtual void randomize() = 0;
+
+    // the site that will be read next, -1 if the genome does not number sites
+    virtual int getSiteIndex() { return -1; }
   };
 
   DataMap dataMap;
@@ -153,6 +158,36 @@ public:
              bool _readDirection = true) = 0;
   virtual double getAlphabetSize() = 0;
 
+  // the sites of this genome, if they are bytes (see
+  // CircularGenome<unsigned char>), as pages of pageSize sites that are all
+  // full but the last. lets translators scan the genome in place without a
+  // Handler. the pages are valid until the genome changes.
+  struct SiteBytes {
+    std::vector<const unsigned char *> pages;
+    int pageSize = 0;
+    int size = 0;
+    unsigned char operator[](int i) const {
+      return pages[i / pageSize][i % pageSize];
+    }
+  };
+  // returns false if the genome can not do this
+  virtual bool siteBytes(SiteBytes &bytes) { return false; }
+
+  // how this genome was made from editParent, so that whatever was translated
+  // from the parent (e.g. MarkovBrain gates) can be reused where sites did not
+  // change. each edit replaced sites [start, start + removed) with inserted new
+  // sites, positions are as they were when the edit was made. editParent is
+  // empty if the edits do not describe this genome.
+  struct Edit {
+    int start;
+    int removed;
+    int inserted;
+  };
+  std::vector<Edit> edits;
+  std::weak_ptr<AbstractGenome> editParent;
+  int editParentVersion = 0; // version of editParent when it was copied
+  int version = 0;           // changes whenever sites change
+
   virtual void copyFrom(std::shared_ptr<AbstractGenome> from) = 0;
 
   virtual void fillRandom() = 0;
@@ -182,6 +217,20 @@ public:
     exit(1);
   }
 
+  // write/read everything needed to carry on a run with this genome (see
+  // GLOBAL-checkpointInterval)
+  virtual void saveCheckpoint(CheckpointWriter &out) {
+    std::cout << "ERROR! In AbstractGenome::saveCheckpoint(). This method has not been "
+            "written for the type of genome use are using.\n  Exiting.";
+    exit(1);
+  }
+
+  virtual void loadCheckpoint(CheckpointReader &in) {
+    std::cout << "ERROR! In AbstractGenome::loadCheckpoint(). This method has not been "
+            "written for the type of genome use are using.\n  Exiting.";
+    exit(1);
+  }
+
   virtual std::string genomeToStr() {
     std::cout << "Warning! In AbstractGenome::genomeToStr()...\n";
     return "";
@@ -207,7 +256,7 @@ public:
     std::vector<std::shared_ptr<AbstractGenome>> genomes;
     loadGenomeFile(fileName, genomes);
     for (auto g : genomes) {
-      if (std::to_string(g->dataMap.getIntVector(key)[0]) == value) {
+      if (std::to_string(g->dataMap.getFirstInt(key)) == value) {
         return g;
       }
     }
@@ -10,6 +10,7 @@
 
 #include "CircularGenome.h"
 #include <Global.h>
+#include <Genome/SiteEncoding.h>
 #include <cmath> // std::nextbefore
 #include <cfloat> // DBL_MAX
 
@@ -207,6 +208,7 @@ void CircularGenome<T>::Handler::writeInt(int value, int valueMin, int valueMax)
 		valueMax = valueMin;
 		valueMin = temp;
 	}
+	genome->dropEdits();
 	std::vector<T> decomposedValue;
 	int writeValueBase = valueMax - valueMin + 1;
 	value = value - valueMin;
@@ -221,7 +223,7 @@ void CircularGenome<T>::Handler::writeInt(int value, int valueMin, int valueMax)
 	}
 	decomposedValue.push_back(value);
 	while ((int)decomposedValue.size() > 0) {  // starting with the last element in decomposedValue, copy into genome.
-		genome->sites[siteIndex] = decomposedValue[(int)decomposedValue.size() - 1];
+		genome->sites.set(siteIndex, decomposedValue[(int)decomposedValue.size() - 1]);
 		advanceIndex();
 		decomposedValue.pop_back();
 	}
@@ -238,11 +240,12 @@ void CircularGenome<double>::Handler::writeInt(int value, int valueMin, int valu
 		valueMin = temp;
 	}
 	valueMax += 1; // do this so that range is inclusive!
+	genome->dropEdits();
 	//if (value  > valueMax) {
 	//	cout << "ERROR : attempting to write value to <double> Circular Genome. \n value is too large!" << endl;
 	//	exit(1);
 	//}
-	genome->sites[siteIndex] = (((double)(value - valueMin) / (double)(valueMax - valueMin)) * genome->alphabetSize);
+	genome->sites.set(siteIndex, (((double)(value - valueMin) / (double)(valueMax - valueMin)) * genome->alphabetSize));
 	advanceIndex();
 }
 
@@ -260,11 +263,12 @@ void CircularGenome<T>::Handler::writeDouble(double value, double valueMin, doub
 		std::cout << "Error: attempting to write double. given range is too small, value: " << value << " is not < valueMax: " << valueMin << " - valueMin: " << valueMin << "\n";
 		exit(1);
 	}
+	genome->dropEdits();
 	// old version: value = ((value - valueMin) / (valueMax - valueMin)) * genome->alphabetSize;
 	//std::cout << value << "   " << valueMax << "   " << valueMin << " = ";
 	value = ((value - valueMin) / (valueMax - valueMin)) * (genome->alphabetSize - 1.0);
 	//std::cout << value << std::endl;
-	genome->sites[siteIndex] = (T)value;
+	genome->sites.set(siteIndex, (T)value);
 	advanceIndex();
 }
 
@@ -279,8 +283,9 @@ void CircularGenome<double>::Handler::writeDouble(double value, double valueMin,
 		std::cout << "Error: attempting to write double. given range is too small, value: " << value << " is not < valueMax: " << valueMin << " - valueMin: " << valueMin << "\n";
 		exit(1);
 	}
+	genome->dropEdits();
 	value = ((value - valueMin) / (valueMax - valueMin)) * genome->alphabetSize;
-	genome->sites[siteIndex] = value;
+	genome->sites.set(siteIndex, value);
 	advanceIndex();
 }
 
@@ -454,23 +459,40 @@ double CircularGenome<T>::getAlphabetSize() {
 	return alphabetSize;
 }
 
+// only unsigned char sites can be read as bytes
+template<class T>
+bool CircularGenome<T>::siteBytes(SiteBytes &bytes) {
+	return false;
+}
+
+template<>
+bool CircularGenome<unsigned char>::siteBytes(SiteBytes &bytes) {
+	sites.pageData(bytes.pages);
+	bytes.pageSize = SiteStore<unsigned char>::pageSize;
+	bytes.size = (int)sites.size();
+	return true;
+}
+
 // randomize this genomes contents
 template<class T>
 void CircularGenome<T>::fillRandom() {
+	dropEdits();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = (T) Random::getDouble(alphabetSize);
+		sites.set(i, (T) Random::getDouble(alphabetSize));
 	}
 }
 
 template<> inline void CircularGenome<double>::fillRandom() {
+	dropEdits();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = Random::getDouble(0, alphabetSize);
+		sites.set(i, Random::getDouble(0, alphabetSize));
 	}
 }
 
 template<> inline void CircularGenome<bool>::fillRandom() {
+	dropEdits();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = (bool)((int)Random::getDouble(alphabetSize));
+		sites.set(i, (bool)((int)Random::getDouble(alphabetSize)));
 	}
 }
 
@@ -478,8 +500,9 @@ template<> inline void CircularGenome<bool>::fillRandom() {
 // This function is to make testing easy.
 template<class T>
 void CircularGenome<T>::fillAcending() {
+	dropEdits();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = ((int)i) % (int) alphabetSize;
+		sites.set(i, ((int)i) % (int) alphabetSize);
 	}
 }
 
@@ -488,8 +511,9 @@ void CircularGenome<T>::fillAcending() {
 // This function is to make testing easy.
 template<class T>
 void CircularGenome<T>::fillConstant(int value) {
+	dropEdits();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = value;
+		sites.set(i, value);
 	}
 }
 
@@ -500,11 +524,9 @@ void CircularGenome<T>::fillConstant(int value) {
 template<class T>
 void CircularGenome<T>::copyFrom(std::shared_ptr<AbstractGenome> from) {
 	auto castFrom = std::dynamic_pointer_cast<CircularGenome<T>>(from);  // we will be pulling all sorts of stuff from this genome so lets just cast it once.
+	dropEdits();
 	alphabetSize = castFrom->alphabetSize;
-	sites.clear();
-	for (auto site : castFrom->sites) {
-		sites.push_back(site);
-	}
+	sites = castFrom->sites;  // shares pages until one of the genomes changes them
 	countPoint = castFrom->countPoint;
 	countPointOffset = castFrom->countPointOffset;
 	countDelete = castFrom->countDelete;
@@ -536,11 +558,16 @@ bool CircularGenome<T>::isEmpty() {
 // if range is provied (not -1) then the new value will be within +/- range of current value
 template<class T>
 void CircularGenome<T>::pointMutate(double range) {
+	pointMutateSite(Random::getIndex((int)sites.size()), range);
+}
+
+// mutate site siteIndex to a new value, as pointMutate()
+template<class T>
+void CircularGenome<T>::pointMutateSite(int siteIndex, double range) {
 	if (range == -1) {
-		sites[Random::getIndex((int)sites.size())] = Random::getIndex((int)alphabetSize);
+		sites.set(siteIndex, Random::getIndex((int)alphabetSize));
 	}
 	else {
-		int siteIndex = Random::getIndex((int)sites.size());
 		int offsetValue;
 		if (CircularGenomeParameters::mutationPointOffsetUniformPL->get(PT) == true) {
 			offsetValue = Random::getInt(1, range) * ((Random::getIndex(2) * 2.0) - 1.0);
@@ -550,18 +577,17 @@ void CircularGenome<T>::pointMutate(double range) {
 		else { //normal/gaussian
 			offsetValue = (int)Random::getNormal(0, range);
 		}
-		sites[siteIndex] = std::max(0, std::min((int)alphabetSize - 1, sites[siteIndex] + offsetValue));
+		sites.set(siteIndex, std::max(0, std::min((int)alphabetSize - 1, sites[siteIndex] + offsetValue)));
 	}
+	logEdit(siteIndex, 1, 1);
 }
 
 template<>
-void CircularGenome<double>::pointMutate(double range) {
+void CircularGenome<double>::pointMutateSite(int siteIndex, double range) {
 	if (range == -1) {
-		sites[Random::getIndex((int)sites.size())] = Random::getDouble(alphabetSize);
+		sites.set(siteIndex, Random::getDouble(alphabetSize));
 	}
 	else {
-		int siteIndex = Random::getIndex((int)sites.size());
-		bool pointOffsetUniform = false;
 		double offsetValue;
 		if (CircularGenomeParameters::mutationPointOffsetUniformPL->get(PT) == true) {
 			offsetValue = Random::getDouble(-range, range);
@@ -570,8 +596,9 @@ void CircularGenome<double>::pointMutate(double range) {
 			offsetValue = Random::getNormal(0, range);
 		}
 		double maxValue = alphabetSize - (std::nextafter(alphabetSize, DBL_MAX) - alphabetSize); // next smallest double value for alphabetSize
-		sites[siteIndex] = std::max(0.0, std::min(maxValue, sites[siteIndex] + (offsetValue)));
+		sites.set(siteIndex, std::max(0.0, std::min(maxValue, sites[siteIndex] + (offsetValue))));
 	}
+	logEdit(siteIndex, 1, 1);
 }
 
 template<class T>
@@ -599,25 +626,39 @@ int CircularGenome<T>::incrementIndel() {
     return countIndel++;
 }
 
+template<class T>
+void CircularGenome<T>::logEdit(int start, int removed, int inserted) {
+	version++;
+	if (!editParent.expired()) {
+		edits.push_back({ start, removed, inserted });
+	}
+}
+
+template<class T>
+void CircularGenome<T>::dropEdits() {
+	version++;
+	edits.clear();
+	editParent.reset();
+}
+
 // apply mutations to this genome
 template<class T>
 void CircularGenome<T>::mutate() {
-	int howManyPoint = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationPointRatePL->get(PT));
-	int howManyPointOffset = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationPointOffsetRatePL->get(PT));
 	int howManyCopy = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationCopyRatePL->get(PT));
 	int howManyDelete = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationDeleteRatePL->get(PT));
 	int howManyIndel = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationIndelRatePL->get(PT));
-	// do some point mutations
-	for (int i = 0; i < howManyPoint; i++) {
-		pointMutate();
+	// do some point mutations, skipping ahead to each site that is hit
+	int nrOfSites = (int)sites.size();
+	Random::forEachSuccess(nrOfSites, CircularGenomeParameters::mutationPointRatePL->get(PT), [this](int siteIndex) {
+		pointMutateSite(siteIndex);
 		incrementPoint();
-	}
+	});
 	// do some pointOffset mutations
 	double pointOffsetRange = CircularGenomeParameters::mutationPointOffsetRangePL->get(PT);
-	for (int i = 0; i < howManyPointOffset; i++) {
-		pointMutate(pointOffsetRange);
+	Random::forEachSuccess(nrOfSites, CircularGenomeParameters::mutationPointOffsetRatePL->get(PT), [this, pointOffsetRange](int siteIndex) {
+		pointMutateSite(siteIndex, pointOffsetRange);
 		incrementPointOffset();
-	}
+	});
 	// do some copy mutations
 	int MaxGenomeSize = CircularGenomeParameters::sizeMaxPL->get(PT);
 	int IMax = CircularGenomeParameters::mutationCopyMaxSizePL->get(PT);
@@ -636,14 +677,12 @@ void CircularGenome<T>::mutate() {
 			exit(1);
 		}
 		int segmentStart = Random::getInt((int)sites.size() - segmentSize);
-		std::vector<T> segment;
-		segment.clear();
-		auto it = sites.begin();
-		segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
+		std::vector<T> segment = sites.slice(segmentStart, segmentSize);
 
 		////insertSegment(segment);
-		it = sites.begin();
-		sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
+		int insertStart = Random::getInt((int)sites.size());
+		sites.insert(insertStart, segment);
+		logEdit(insertStart, 0, segmentSize);
 
 		//cout << sites.size() << endl;
 
@@ -665,7 +704,8 @@ void CircularGenome<T>::mutate() {
 			exit(1);
 		}
 		int segmentStart = Random::getInt(((int)sites.size()) - segmentSize);
-		sites.erase(sites.begin() + segmentStart, sites.begin() + segmentStart + segmentSize);
+		sites.erase(segmentStart, segmentSize);
+		logEdit(segmentStart, segmentSize, 0);
 
 		incrementDelete();
 	}
@@ -687,15 +727,13 @@ void CircularGenome<T>::mutate() {
 
 		// create a new genome segment
 		std::vector<T> segment;
-		auto it = sites.begin(); // i.e. iterator
 
 		if (copyFirst) {
 			// if copy before delete
 			// copy a portion of the genome into segment
 			int segmentStart = Random::getInt((int)sites.size() - segmentSize); // where to copy from
 			int deleteStart = Random::getInt((int)sites.size() - segmentSize); // where to delete from
-			segment.clear();
-			segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
+			segment = sites.slice(segmentStart, segmentSize);
 
 /*
             std::cout << "\ncopyFirst\ngenome: ";
@@ -711,7 +749,8 @@ void CircularGenome<T>::mutate() {
 */
 
 			// delete a portion of the genome of the same size
-			sites.erase(it + deleteStart, it + deleteStart + segmentSize);
+			sites.erase(deleteStart, segmentSize);
+			logEdit(deleteStart, segmentSize, 0);
 
 /*
 			std::cout << "\ngenome after delete: ";
@@ -722,18 +761,22 @@ void CircularGenome<T>::mutate() {
 			// insert the copied sites back into genome
 			if (insertMethod == 0) {
 				// copy to random location
-				sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
+				int insertStart = Random::getInt((int)sites.size());
+				sites.insert(insertStart, segment);
+				logEdit(insertStart, 0, segmentSize);
 			}
 			else if (insertMethod == 1) {
 				// replace deleted segment
-				sites.insert(it + deleteStart, segment.begin(), segment.end());
+				sites.insert(deleteStart, segment);
+				logEdit(deleteStart, 0, segmentSize);
 			}
 			else if (insertMethod == 2) {
 				// insert segment just in front of copied sites
 				if (segmentStart > deleteStart) { // note if deleteStart is in copied segment things are weird.
 					segmentStart -= deleteStart;  // but no matter what we do, it's going to be weird...
 				}
-				sites.insert(it + segmentStart, segment.begin(), segment.end());
+				sites.insert(segmentStart, segment);
+				logEdit(segmentStart, 0, segmentSize);
 			}
 /*
 			std::cout << "\ngenome after insert: ";
@@ -746,7 +789,8 @@ void CircularGenome<T>::mutate() {
 			// delete before copy (deleted sites cannot be copied)
 			// delete a portion of the genome
 			int deleteStart = Random::getInt((int)sites.size() - segmentSize); // where to delete from
-			sites.erase(it + deleteStart, it + deleteStart + segmentSize);
+			sites.erase(deleteStart, segmentSize);
+			logEdit(deleteStart, segmentSize, 0);
 
             if (segmentSize > sites.size()){
                 std::cout << "ERROR: in curlarGenome<T>::mutate(), segmentSize for indel is > then sites.size() after deletion!\nUse a larger genome relitive to Indel min/max.\nExiting!" << std::endl;
@@ -755,21 +799,24 @@ void CircularGenome<T>::mutate() {
             }
 			// copy a portion of the genome into segment
 			int segmentStart = Random::getInt((int)sites.size() - segmentSize);
-			segment.clear();
-			segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
+			segment = sites.slice(segmentStart, segmentSize);
 
 			// insert the copied sites back into genome
 			if (insertMethod == 0) {
 				// copy to random location
-				sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
+				int insertStart = Random::getInt((int)sites.size());
+				sites.insert(insertStart, segment);
+				logEdit(insertStart, 0, segmentSize);
 			}
 			else if (insertMethod == 1) {
 				// replace deleted segment
-				sites.insert(it + deleteStart, segment.begin(), segment.end());
+				sites.insert(deleteStart, segment);
+				logEdit(deleteStart, 0, segmentSize);
 			}
 			else if (insertMethod == 2) {
 				// insert segment just in front of copied sites
-				sites.insert(it + segmentStart, segment.begin(), segment.end());
+				sites.insert(segmentStart, segment);
+				logEdit(segmentStart, 0, segmentSize);
 			}
 		}
 		incrementIndel();
@@ -782,6 +829,8 @@ template<class T>
 std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFrom(std::shared_ptr<AbstractGenome> parent) {
 	auto newGenome = std::make_shared<CircularGenome<T>>(PT);
 	newGenome->copyFrom(parent);
+	newGenome->editParent = parent;  // so mutate() records edits
+	newGenome->editParentVersion = parent->version;
     newGenome->mutate();
 	newGenome->recordDataMap();
 	return newGenome;
@@ -821,7 +870,7 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(std
 		//cout << "many parent" << endl;
 
 		// extract the sites list from each parent
-		std::vector<std::vector<T>> parentSites;
+		std::vector<SiteStore<T>> parentSites;
 		for (auto parent : parents) {
 			parentSites.push_back(std::dynamic_pointer_cast<CircularGenome<T>>(parent)->sites);
 		}
@@ -856,7 +905,7 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(std
 			lastPick = pick;
 			// add the segment to this chromosome
 			//cout << "(" << parentSites[pick].size() << ") "<< c << ": " << (int)((double)parentSites[pick].size()*crossLocations[c]) << " " << (int)((double)parentSites[pick].size()*crossLocations[c+1]) << " " << flush;
-			newGenome->sites.insert(newGenome->sites.end(), parentSites[pick].begin() + (int) ((double) parentSites[pick].size() * crossLocations[c]), parentSites[pick].begin() + (int) ((double) parentSites[pick].size() * crossLocations[c + 1]));
+			newGenome->sites.append(parentSites[pick], (int) ((double) parentSites[pick].size() * crossLocations[c]), (int) ((double) parentSites[pick].size() * crossLocations[c + 1]));
 			//cout << " ++ " << flush;
 		}
 	}
@@ -889,7 +938,12 @@ template<class T>
 DataMap CircularGenome<T>::serialize(std::string& name) {
 	DataMap serialDataMap;
 	serialDataMap.set(name + "_genomeLength", countSites());
-	serialDataMap.set(name + "_sites", genomeToStr());
+	if (AbstractGenome::serializeBinaryPL->get(PT)) {
+		serialDataMap.set(name + "_sites", SiteEncoding::encode<T>(sites));
+	}
+	else {
+		serialDataMap.set(name + "_sites", genomeToStr());
+	}
 	return serialDataMap;
 }
 
@@ -908,6 +962,13 @@ void CircularGenome<T>::deserialize(std::shared_ptr<ParametersTable> PT, std::un
 	convertString(orgData[name + "_genomeLength"], genomeLength);
 
 	std::string allSites = orgData[name + "_sites"];
+	dropEdits();
+	if (SiteEncoding::isBinary(allSites)) {
+		std::vector<T> values;
+		SiteEncoding::decode(allSites, values, "CircularGenome<T>::deserialize");
+		sites.assign(values);
+		return;
+	}
 	std::stringstream ss(allSites);
 
   bool streamNotEmpty(true);
@@ -933,14 +994,21 @@ void CircularGenome<unsigned char>::deserialize(std::shared_ptr<ParametersTable>
 	std::string nextString;
 	int value;
 	// make sure that data has needed columns
-	if (orgData.find("GENOME_" + name + "_sites") == orgData.end() || orgData.find("GENOME_" + name + "_genomeLength") == orgData.end()) {
-		std::cout << "  In CircularGenome<T>::deserialize :: can not find either GENOME_" + name + "_sites or GENOME_" + name + "_genomeLength.\n  exiting" << std::endl;
+	if (orgData.find(name + "_sites") == orgData.end() || orgData.find(name + "_genomeLength") == orgData.end()) {
+		std::cout << "  In CircularGenome<T>::deserialize :: can not find either " + name + "_sites or " + name + "_genomeLength.\n  exiting" << std::endl;
 		exit(1);
 	}
 	int genomeLength;
-	convertString(orgData["GENOME_" + name + "_genomeLength"], genomeLength);
+	convertString(orgData[name + "_genomeLength"], genomeLength);
 
-	std::string allSites = orgData["GENOME_" + name + "_sites"];
+	std::string allSites = orgData[name + "_sites"];
+	dropEdits();
+	if (SiteEncoding::isBinary(allSites)) {
+		std::vector<unsigned char> values;
+		SiteEncoding::decode(allSites, values, "CircularGenome<T>::deserialize");
+		sites.assign(values);
+		return;
+	}
 	std::stringstream ss(allSites);
 
 	sites.clear();
@@ -962,6 +1030,31 @@ void CircularGenome<unsigned char>::deserialize(std::shared_ptr<ParametersTable>
 
 
 
+template<class T>
+void CircularGenome<T>::saveCheckpoint(CheckpointWriter &out) {
+	out.put(alphabetSize);
+	out.put(countPoint);
+	out.put(countPointOffset);
+	out.put(countCopy);
+	out.put(countDelete);
+	out.put(countIndel);
+	out.put(sites.slice(0, sites.size()));
+}
+
+template<class T>
+void CircularGenome<T>::loadCheckpoint(CheckpointReader &in) {
+	in.get(alphabetSize);
+	in.get(countPoint);
+	in.get(countPointOffset);
+	in.get(countCopy);
+	in.get(countDelete);
+	in.get(countIndel);
+	std::vector<T> values;
+	in.get(values);
+	dropEdits();
+	sites.assign(values);
+}
+
 template<class T>
 void CircularGenome<T>::recordDataMap() {
 	dataMap.set("alphabetSize", alphabetSize);
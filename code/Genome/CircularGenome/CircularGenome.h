@@ -25,6 +25,8 @@
 #include <Utilities/Random.h>
 #include <Genome/AbstractGenome.h>
 
+#include "SiteStore.h"
+
 // needed to move static values to own class because of templating.
 class CircularGenomeParameters {
 public:
@@ -106,10 +108,13 @@ public:
 		// move this handler to a random location in genome
 		virtual void randomize() override;
 		virtual std::vector<std::vector<int>> readTable(std::pair<int, int> tableSize, std::pair<int, int> tableMaxSize, std::pair<int, int> valueRange, int code = -1, int CodingRegionIndex = 0) override;
+		virtual int getSiteIndex() override {
+			return siteIndex;
+		}
 
 	};
 
-	std::vector<T> sites;
+	SiteStore<T> sites;
 	double alphabetSize;
 
 	CircularGenome() = delete;
@@ -138,6 +143,7 @@ public:
 	virtual std::shared_ptr<AbstractGenome::Handler> newHandler(std::shared_ptr<AbstractGenome> _genome, bool _readDirection = true) override;
 
 	virtual double getAlphabetSize() override;
+	virtual bool siteBytes(SiteBytes &bytes) override;
 
 	// randomize this genomes contents
 	virtual void fillRandom() override;
@@ -164,6 +170,7 @@ public:
 	virtual bool isEmpty() override;
 
 	virtual void pointMutate(double range = -1);
+	virtual void pointMutateSite(int siteIndex, double range = -1);
 
 	int countPoint = 0;
 	int countPointOffset = 0;
@@ -177,6 +184,11 @@ public:
 	virtual int incrementDelete();
 	virtual int incrementIndel();
 
+	// record a change to sites in edits (if this genome has an editParent)
+	void logEdit(int start, int removed, int inserted);
+	// sites changed in a way that edits can not describe
+	void dropEdits();
+
 	// apply mutations to this genome
 	virtual void mutate() override;
 
@@ -206,6 +218,8 @@ public:
 
 	virtual DataMap serialize(std::string& name) override;
 	virtual void deserialize(std::shared_ptr<ParametersTable> PT, std::unordered_map<std::string, std::string>& orgData, std::string& name) override;
+	virtual void saveCheckpoint(CheckpointWriter &out) override;
+	virtual void loadCheckpoint(CheckpointReader &in) override;
 
 	virtual void recordDataMap() override;
 
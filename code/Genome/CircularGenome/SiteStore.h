@@ -0,0 +1,180 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+// The sites of a CircularGenome, kept in fixed size pages that are shared
+// between copies until one of them writes to a page (copy on write). Copying
+// a genome (to make an offspring, or to keep an ancestor in a line of
+// descent) only copies page pointers, and a point mutation copies one page.
+// Pages are all full but the last, so site i is always in page i / pageSize.
+template <class T> class SiteStore {
+public:
+  static const int pageSize = 128;
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  T operator[](size_t i) const { return (*pages[i / pageSize])[i % pageSize]; }
+
+  void set(size_t i, T value) { writablePage(i / pageSize)[i % pageSize] = value; }
+
+  void push_back(T value) {
+    if (count % pageSize == 0)
+      pages.push_back(std::make_shared<Page>());
+    writablePage(pages.size() - 1)[count % pageSize] = value;
+    count++;
+  }
+
+  void clear() {
+    pages.clear();
+    count = 0;
+  }
+
+  // replace all sites with values
+  void assign(const std::vector<T> &values) {
+    clear();
+    for (size_t start = 0; start < values.size(); start += pageSize) {
+      auto page = std::make_shared<Page>();
+      size_t n = std::min<size_t>(pageSize, values.size() - start);
+      std::copy(values.begin() + start, values.begin() + start + n,
+                page->begin());
+      pages.push_back(page);
+    }
+    count = values.size();
+  }
+
+  // new sites are T()
+  void resize(size_t newSize) {
+    if (newSize < count)
+      truncate(newSize);
+    while (count < newSize)
+      push_back(T());
+  }
+
+  // copy of sites [start, start + length)
+  std::vector<T> slice(size_t start, size_t length) const {
+    std::vector<T> values(length);
+    for (size_t i = 0; i < length; i++)
+      values[i] = (*this)[start + i];
+    return values;
+  }
+
+  // the sites of each page, in order (read only, see writablePage)
+  void pageData(std::vector<const T *> &out) const {
+    out.clear();
+    for (auto &page : pages)
+      out.push_back(page->data());
+  }
+
+  // copy all sites into out
+  void copyTo(T *out) const { copyRange(0, count, out); }
+
+  // add sites [start, end) of from to the end. whole pages that line up are
+  // shared rather than copied
+  void append(const SiteStore &from, size_t start, size_t end) {
+    if (count == 0 && start == 0 && end == from.count) {
+      *this = from; // share every page
+      return;
+    }
+    while (start < end) {
+      size_t p = start / pageSize, offset = start % pageSize;
+      size_t n = std::min<size_t>(pageSize - offset, end - start);
+      if (count % pageSize == 0 && n == pageSize) {
+        pages.push_back(from.pages[p]);
+        count += pageSize;
+      } else {
+        write(from.pages[p]->begin() + offset, n);
+      }
+      start += n;
+    }
+  }
+
+  // sites after position are shifted a page at a time. pages no other genome
+  // holds are written in place, so only shared pages are copied
+  void insert(size_t position, const std::vector<T> &values) {
+    splice(position, 0, values.begin(), values.size());
+  }
+
+  // remove sites [start, start + length)
+  void erase(size_t start, size_t length) {
+    splice(start, length, (const T *)nullptr, 0);
+  }
+
+private:
+  using Page = std::array<T, pageSize>;
+  std::vector<std::shared_ptr<Page>> pages;
+  size_t count = 0;
+
+  // only a page that no other genome holds may be written to
+  Page &writablePage(size_t p) {
+    if (pages[p].use_count() > 1)
+      pages[p] = std::make_shared<Page>(*pages[p]);
+    return *pages[p];
+  }
+
+  template <class Out> void copyRange(size_t start, size_t end, Out out) const {
+    while (start < end) {
+      size_t p = start / pageSize, offset = start % pageSize;
+      size_t n = std::min<size_t>(pageSize - offset, end - start);
+      out = std::copy(pages[p]->begin() + offset, pages[p]->begin() + offset + n,
+                      out);
+      start += n;
+    }
+  }
+
+  // add n sites from values (an iterator, std::vector<bool> has no data())
+  // at count, reusing any pages already past count
+  template <class It> void write(It values, size_t n) {
+    while (n > 0) {
+      size_t p = count / pageSize, offset = count % pageSize;
+      if (p == pages.size())
+        pages.push_back(std::make_shared<Page>());
+      size_t m = std::min<size_t>(n, pageSize - offset);
+      std::copy(values, values + m, writablePage(p).begin() + offset);
+      values += m;
+      n -= m;
+      count += m;
+    }
+  }
+
+  // replace sites [position, position + removed) with n sites from values
+  template <class It>
+  void splice(size_t position, size_t removed, It values, size_t n) {
+    size_t end = count;
+    if (n == 0) { // the tail moves down, so it can be copied in place
+      count = position;
+      for (size_t from = position + removed; from < end;) {
+        size_t p = from / pageSize, offset = from % pageSize;
+        size_t m = std::min<size_t>(pageSize - offset, end - from);
+        // if write copies pages[p] (shared), the old page is still held
+        write(pages[p]->begin() + offset, m);
+        from += m;
+      }
+    } else {
+      std::vector<T> tail(end - position - removed);
+      copyRange(position + removed, end, tail.begin());
+      count = position;
+      write(values, n);
+      write(tail.begin(), tail.size());
+    }
+    pages.resize((count + pageSize - 1) / pageSize);
+  }
+
+  void truncate(size_t newSize) {
+    pages.resize((newSize + pageSize - 1) / pageSize);
+    count = newSize;
+  }
+};
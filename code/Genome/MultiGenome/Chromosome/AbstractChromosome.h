@@ -88,6 +88,20 @@ public:
 
   virtual std::string chromosomeToStr() = 0;
 
+  // binary (base64) form of the sites, see Genome/SiteEncoding.h
+  virtual std::string chromosomeToBinaryStr() {
+    std::cout << "ERROR: chromosomeToBinaryStr() in AbstractChromosome was called!\n This has "
+            "not been implemented yet the chromosome class you are using!\n";
+    exit(1);
+  }
+
+  virtual void readChromosomeFromBinaryStr(const std::string &text) {
+    std::cout << "ERROR: readChromosomeFromBinaryStr(const string &text) in "
+            "AbstractChromosome was called!\n This has not been implemented "
+            "yet the chromosome class you are using!\n";
+    exit(1);
+  }
+
   virtual void resize(int size) {
     std::cout << "ERROR: resize(int size) in AbstractChromosome was called!\n This "
             "has not been implemented yet the chromosome class you are "
@@ -148,6 +162,12 @@ public:
     exit(1);
   }
 
+  virtual void mutatePoint(int index) {
+    std::cout << "ERROR: mutatePoint(int index) in AbstractChromosome was called!\n This has "
+            "not been implemented yet the chromosome class you are using!\n";
+    exit(1);
+  }
+
   virtual void mutateCopy(int minSize, int maxSize, int chromosomeSizeMax) {
     std::cout << "ERROR: mutateCopy(int minSize, int maxSize, int "
             "chromosomeSizeMax) in AbstractChromosome was called!\n This has "
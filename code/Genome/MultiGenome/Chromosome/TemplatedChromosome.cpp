@@ -10,6 +10,7 @@
 
 #include <limits>
 #include "TemplatedChromosome.h"
+#include <Genome/SiteEncoding.h>
 
 
 // set a coding region value if that value is > -1 (values < 0 denote that the
@@ -454,6 +455,15 @@ template <> std::string TemplatedChromosome<unsigned char>::chromosomeToStr() {
   return ss.str();
 }
 
+template <class T> std::string TemplatedChromosome<T>::chromosomeToBinaryStr() {
+  return SiteEncoding::encode<T>(sites);
+}
+
+template <class T>
+void TemplatedChromosome<T>::readChromosomeFromBinaryStr(const std::string &text) {
+  SiteEncoding::decode(text, sites, "TemplatedChromosome::readChromosomeFromBinaryStr");
+}
+
 template <class T> void TemplatedChromosome<T>::resize(int size) {
   sites.resize(size);
 }
@@ -521,7 +531,11 @@ void TemplatedChromosome<T>::insertSegment(
 }
 
 template <class T> void TemplatedChromosome<T>::mutatePoint() {
-  sites[Random::getIndex(sites.size())] = (T)Random::getDouble(alphabetSize);
+  mutatePoint(Random::getIndex(sites.size()));
+}
+
+template <class T> void TemplatedChromosome<T>::mutatePoint(int index) {
+  sites[index] = (T)Random::getDouble(alphabetSize);
 }
 
 // mutate chromosome by getting a copy of a segment of this chromosome and
@@ -653,8 +667,8 @@ template <> inline void TemplatedChromosome<double>::fillRandom() {
   TemplatedChromosome<double>::fillRandom(sites.size());
 }
 
-template <> inline void TemplatedChromosome<double>::mutatePoint() {
-  sites[Random::getIndex(sites.size())] = Random::getDouble(alphabetSize);
+template <> inline void TemplatedChromosome<double>::mutatePoint(int index) {
+  sites[index] = Random::getDouble(alphabetSize);
 }
 
 // unsigned char constructors
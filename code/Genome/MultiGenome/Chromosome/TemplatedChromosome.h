@@ -126,6 +126,8 @@ public:
                                     int _chromosomeLength) override;
   // convert a chromosome to a string
   virtual std::string chromosomeToStr() override;
+  virtual std::string chromosomeToBinaryStr() override;
+  virtual void readChromosomeFromBinaryStr(const std::string &text) override;
   virtual void resize(int size) override;
   virtual int size() override;
   virtual DataMap getFixedStats() override;
@@ -147,6 +149,8 @@ public:
   // random.
   virtual void insertSegment(std::shared_ptr<AbstractChromosome> segment) override;
   virtual void mutatePoint() override;
+  // set the site at index to a random value
+  virtual void mutatePoint(int index) override;
   // mutate chromosome by getting a copy of a segment of this chromosome and
   // inserting that segment randomly into this chromosome
   virtual void mutateCopy(int minSize, int maxSize,
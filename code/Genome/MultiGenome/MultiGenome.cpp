@@ -10,6 +10,7 @@
 
 #include "MultiGenome.h"
 #include <Global.h>
+#include <Genome/SiteEncoding.h>
 
 // Initialize Parameters
 
@@ -415,15 +416,14 @@ void MultiGenome::mutate() {
 	for (auto chromosome : chromosomes) {
 		int nucleotides = chromosome->size();
 
-		int howManyPoint = Random::getBinomial(nucleotides, pointMutationRatePL->get(PT));
 		int howManyCopy = Random::getBinomial(nucleotides, insertionRatePL->get(PT));
 		int howManyDelete = Random::getBinomial(nucleotides, deletionRatePL->get(PT));
 
 
-		// do some point mutations
-		for (int i = 0; i < howManyPoint; i++) {
-			chromosome->mutatePoint();
-		}
+		// do some point mutations, skipping ahead to each site that is hit
+		Random::forEachSuccess(nucleotides, pointMutationRatePL->get(PT), [&chromosome](int index) {
+			chromosome->mutatePoint(index);
+		});
 		// do some copy mutations
 		int MaxChromosomeSize = maxChromosomeSizePL->get(PT);
 		int IMax = insertionMaxSizePL->get(PT);
@@ -552,7 +552,18 @@ DataMap MultiGenome::serialize(std::string& name) {
 	chromosomeLengths.pop_back();
 	chromosomeLengths += "";
 	serialDataMap.set(name + "_chromosomeLengths", chromosomeLengths);
-	serialDataMap.set(name + "_sites", genomeToStr());
+	if (AbstractGenome::serializeBinaryPL->get(PT)) {
+		// one binary block per chromosome
+		std::string S = "";
+		for (size_t c = 0; c < chromosomes.size(); c++) {
+			S.append(chromosomes[c]->chromosomeToBinaryStr() + FileManager::separator);
+		}
+		S.pop_back();
+		serialDataMap.set(name + "_sites", S);
+	}
+	else {
+		serialDataMap.set(name + "_sites", genomeToStr());
+	}
 	return serialDataMap;
 }
 
@@ -568,6 +579,15 @@ void MultiGenome::deserialize(std::shared_ptr<ParametersTable> PT, std::unordere
 	convertCSVListToVector(orgData[name + "_chromosomeLengths"], _chromosomeLengths);
 	std::string sitesType = AbstractGenome::genomeSitesTypePL->get(PT);
 	std::string allSites = orgData[name + "_sites"];
+	if (SiteEncoding::isBinary(allSites)) {
+		std::stringstream blocks(allSites);
+		std::string block;
+		for (size_t i = 0; i < _chromosomeLengths.size(); i++) {
+			std::getline(blocks, block, FileManager::separator);
+			chromosomes[i]->readChromosomeFromBinaryStr(block);
+		}
+		return;
+	}
 	std::stringstream ss(allSites);
 
 	char nextChar;
@@ -578,6 +598,25 @@ void MultiGenome::deserialize(std::shared_ptr<ParametersTable> PT, std::unordere
 	}
 }
 
+void MultiGenome::saveCheckpoint(CheckpointWriter &out) {
+	out.put(ploidy);
+	out.put(static_cast<uint64_t>(chromosomes.size()));
+	for (auto chromosome : chromosomes) {
+		out.put(chromosome->chromosomeToBinaryStr());
+	}
+}
+
+void MultiGenome::loadCheckpoint(CheckpointReader &in) {
+	in.get(ploidy);
+	if (in.get<uint64_t>() != chromosomes.size()) {
+		std::cout << "  In MultiGenome::loadCheckpoint :: checkpoint has a different number of chromosomes than this genome.\n  exiting" << std::endl;
+		exit(1);
+	}
+	for (auto chromosome : chromosomes) {
+		chromosome->readChromosomeFromBinaryStr(in.get<std::string>());
+	}
+}
+
 /////////////// FIX FIX FIX ////////////////////
 
 void MultiGenome::recordDataMap() {
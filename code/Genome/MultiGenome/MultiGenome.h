@@ -212,6 +212,8 @@ public:
   virtual void deserialize(std::shared_ptr<ParametersTable> PT,
                            std::unordered_map<std::string, std::string> &orgData,
                            std::string &name) override;
+  virtual void saveCheckpoint(CheckpointWriter &out) override;
+  virtual void loadCheckpoint(CheckpointReader &in) override;
 
   virtual void recordDataMap() override;
 
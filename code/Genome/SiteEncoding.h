@@ -0,0 +1,168 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Binary form of a run of genome sites, for organism files. The sites are
+// stored raw (host byte order, little-endian on the platforms MABE builds
+// for) behind an 8 byte header, and the whole thing is base64 encoded so
+// that it sits in a csv cell like the text form does:
+//
+//   "b64:" base64( version | site size | site kind | 0 | site count (uint32) | sites )
+//
+// version is bumped if the layout ever changes; decode() refuses versions
+// it does not know. site kind is 'u', 'i', 'f' or 'b' (bool).
+namespace SiteEncoding {
+
+const std::string prefix = "b64:";
+const unsigned char version = 1;
+const size_t headerSize = 8;
+
+// true if text was written by encode() (and not as comma separated values)
+inline bool isBinary(const std::string &text) {
+  return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+template <class T> unsigned char siteKind() {
+  return std::is_same<T, bool>::value
+             ? 'b'
+             : std::is_floating_point<T>::value
+                   ? 'f'
+                   : std::is_signed<T>::value ? 'i' : 'u';
+}
+
+inline std::string toBase64(const std::string &bytes) {
+  static const char digits[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string text;
+  text.reserve(((bytes.size() + 2) / 3) * 4);
+  size_t i = 0;
+  for (; i + 2 < bytes.size(); i += 3) {
+    uint32_t n = ((unsigned char)bytes[i] << 16) |
+                 ((unsigned char)bytes[i + 1] << 8) |
+                 (unsigned char)bytes[i + 2];
+    text += digits[(n >> 18) & 63];
+    text += digits[(n >> 12) & 63];
+    text += digits[(n >> 6) & 63];
+    text += digits[n & 63];
+  }
+  if (i < bytes.size()) {
+    uint32_t n = (unsigned char)bytes[i] << 16;
+    if (i + 1 < bytes.size())
+      n |= (unsigned char)bytes[i + 1] << 8;
+    text += digits[(n >> 18) & 63];
+    text += digits[(n >> 12) & 63];
+    text += (i + 1 < bytes.size()) ? digits[(n >> 6) & 63] : '=';
+    text += '=';
+  }
+  return text;
+}
+
+// returns false if text holds anything other than base64 digits and padding
+inline bool fromBase64(const char *text, size_t length, std::string &bytes) {
+  static signed char values[256];
+  static bool ready = [] {
+    std::memset(values, -1, sizeof(values));
+    const char digits[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (int i = 0; i < 64; i++)
+      values[(unsigned char)digits[i]] = i;
+    return true;
+  }();
+  (void)ready;
+  bytes.clear();
+  bytes.reserve((length / 4) * 3);
+  uint32_t n = 0;
+  int bits = 0;
+  for (size_t i = 0; i < length && text[i] != '='; i++) {
+    int v = values[(unsigned char)text[i]];
+    if (v < 0)
+      return false;
+    n = (n << 6) | v;
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      bytes += (char)((n >> bits) & 255);
+    }
+  }
+  return true;
+}
+
+// sites can be anything with size() and operator[] returning T
+template <class T, class Sites> std::string encode(const Sites &sites) {
+  uint32_t count = (uint32_t)sites.size();
+  std::string bytes(headerSize + count * sizeof(T), '\0');
+  bytes[0] = version;
+  bytes[1] = sizeof(T);
+  bytes[2] = siteKind<T>();
+  for (int b = 0; b < 4; b++)
+    bytes[4 + b] = (char)((count >> (8 * b)) & 255);
+  char *out = &bytes[headerSize];
+  for (uint32_t i = 0; i < count; i++) {
+    T value = sites[i];
+    std::memcpy(out + i * sizeof(T), &value, sizeof(T));
+  }
+  return prefix + toBase64(bytes);
+}
+
+// decode text written by encode<T>() into sites. where names the caller
+// for error messages. exits if text is damaged or holds another site type.
+template <class T>
+void decode(const std::string &text, std::vector<T> &sites,
+            const std::string &where) {
+  std::string bytes;
+  if (!isBinary(text) ||
+      !fromBase64(text.data() + prefix.size(), text.size() - prefix.size(),
+                  bytes) ||
+      bytes.size() < headerSize) {
+    std::cout << "  In " << where
+              << " :: binary sites are not valid base64.\n  exiting"
+              << std::endl;
+    exit(1);
+  }
+  if ((unsigned char)bytes[0] != version) {
+    std::cout << "  In " << where << " :: binary sites have version "
+              << (int)(unsigned char)bytes[0] << ", only version "
+              << (int)version << " can be read.\n  exiting" << std::endl;
+    exit(1);
+  }
+  if ((size_t)bytes[1] != sizeof(T) ||
+      (unsigned char)bytes[2] != siteKind<T>()) {
+    std::cout << "  In " << where
+              << " :: binary sites were saved with a different sitesType "
+                 "than this genome has.\n  exiting"
+              << std::endl;
+    exit(1);
+  }
+  uint32_t count = 0;
+  for (int b = 0; b < 4; b++)
+    count |= (uint32_t)(unsigned char)bytes[4 + b] << (8 * b);
+  if (bytes.size() != headerSize + count * sizeof(T)) {
+    std::cout << "  In " << where
+              << " :: binary sites are truncated.\n  exiting" << std::endl;
+    exit(1);
+  }
+  sites.resize(count);
+  const char *in = &bytes[headerSize];
+  for (uint32_t i = 0; i < count; i++) {
+    T value;
+    std::memcpy(&value, in + i * sizeof(T), sizeof(T));
+    sites[i] = value;
+  }
+}
+
+} // namespace SiteEncoding
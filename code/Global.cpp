@@ -16,6 +16,18 @@ std::shared_ptr<ParameterLink<int>> Global::randomSeedPL =
                                    "seed for random number generator, if -1 "
                                    "random number generator will be seeded "
                                    "randomly");
+std::shared_ptr<ParameterLink<int>> Global::threadsPL =
+    Parameters::register_parameter(
+        "GLOBAL-threads", 1,
+        "number of threads used to evaluate organisms (only used by worlds "
+        "that support parallel evaluation) and to make offspring in the "
+        "optimizers. results do not depend on the number of threads");
+std::shared_ptr<ParameterLink<bool>> Global::pipelineArchivePL =
+    Parameters::register_parameter(
+        "GLOBAL-pipelineArchive", false,
+        "if true, archivists write their files on a background thread while "
+        "the next update is evaluated (data is copied when the archivist runs, "
+        "so files are the same as when this is false)");
 std::shared_ptr<ParameterLink<int>> Global::updatesPL =
     Parameters::register_parameter("GLOBAL-updates", 100,
                                    "how long the program will run");
@@ -41,6 +53,13 @@ std::shared_ptr<ParameterLink<std::string>> Global::outputPrefixPL =
     Parameters::register_parameter(
         "GLOBAL-outputPrefix", std::string("./"),
         "Directory and prefix specifying where data files will be written");
+std::shared_ptr<ParameterLink<int>> Global::checkpointIntervalPL =
+    Parameters::register_parameter(
+        "GLOBAL-checkpointInterval", 0,
+        "if > 0, every this many updates the whole run is saved to "
+        "checkpoint.mabe (with outputPrefix) so that it can be continued with "
+        "-r. a restarted run gives the same results as one that was not "
+        "stopped. only works with the Default archivist");
 
 // shared_ptr<ParameterLink<string>> Global::groupNameSpacesPL =
 // Parameters::register_parameter("GLOBAL-groups", (string) "[]", "name spaces
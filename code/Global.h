@@ -26,6 +26,10 @@ public:
   static std::shared_ptr<ParameterLink<int>> randomSeedPL;
   // seed for random number generator if -1 random number generator will be
   // seeded randomly
+  static std::shared_ptr<ParameterLink<int>>
+      threadsPL; // number of threads used by worlds that evaluate in parallel
+  static std::shared_ptr<ParameterLink<bool>>
+      pipelineArchivePL; // write archive files while the next update runs
   
   static std::shared_ptr<ParameterLink<int>>
       updatesPL; // run until there is a MCRA at this time
@@ -41,6 +45,8 @@ public:
 
   static std::shared_ptr<ParameterLink<std::string>>
       outputPrefixPL; // where files will be written
+  static std::shared_ptr<ParameterLink<int>>
+      checkpointIntervalPL; // how often to write a checkpoint (0 = never)
 
   // static shared_ptr<ParameterLink<string>> groupNameSpacesPL;
 
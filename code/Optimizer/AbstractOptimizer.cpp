@@ -10,6 +10,8 @@
 
 #include "AbstractOptimizer.h"
 
+#include <Utilities/ThreadPool.h>
+
 /*
 #include <algorithm>
 #include <math.h>
@@ -26,6 +28,29 @@ std::shared_ptr<ParameterLink<std::string>>
                                             // outputMethod;
 ////// OPTIMIZER-optimizer is actually set by Modules.h //////
 
+std::vector<std::shared_ptr<Organism>> AbstractOptimizer::makeMutatedOffspring(
+    const std::vector<std::vector<std::shared_ptr<Organism>>> &parentLists,
+    bool manyParents) {
+  // phase one - make offspring (IDs, lineage and parents offspringCount)
+  std::vector<std::shared_ptr<Organism>> offspring;
+  offspring.reserve(parentLists.size());
+  for (auto const &parents : parentLists) {
+    offspring.push_back(manyParents
+                            ? parents[0]->makeOffspringFromMany(parents)
+                            : parents[0]->makeOffspringFrom(parents[0]));
+  }
+
+  // phase two - copy and mutate genomes and build brains
+  getCommonPool().parallelFor(static_cast<int>(offspring.size()), [&](int i) {
+    if (manyParents) {
+      offspring[i]->inheritMutatedFromMany(parentLists[i]);
+    } else {
+      offspring[i]->inheritMutatedFrom(parentLists[i][0]);
+    }
+  });
+  return offspring;
+}
+
 /*
  * Optimizer::makeNextGeneration(vector<Genome*> population, vector<double> W)
  * place holder function, copies population to make new population
@@ -41,6 +41,16 @@ public:
   // makeNextGeneration(vector<shared_ptr<Organism>> &population) = 0;
   virtual void optimize(std::vector<std::shared_ptr<Organism>> &population) = 0;
 
+  // make one offspring for each list of parents in parentLists (in order).
+  // Offspring are created serially (so IDs and lineage are assigned in
+  // order), then genomes are mutated and brains built in parallel
+  // (GLOBAL-threads threads). If manyParents each offspring is made as with
+  // makeMutatedOffspringFromMany (even from a single parent), otherwise as
+  // with makeMutatedOffspringFrom using the first parent in each list.
+  std::vector<std::shared_ptr<Organism>> makeMutatedOffspring(
+      const std::vector<std::vector<std::shared_ptr<Organism>>> &parentLists,
+      bool manyParents);
+
   virtual void cleanup(std::vector<std::shared_ptr<Organism>> &population) {
     std::vector<std::shared_ptr<Organism>> newPopulation;
     for (auto org : population) {
@@ -59,6 +59,7 @@ IslandsOptimizer::IslandsOptimizer(std::shared_ptr<ParametersTable> PT_)
 }
 
 void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &population) {
+	static const DataMap::Key islandKey("IsOp_island");
 	std::vector<std::vector<std::shared_ptr<Organism>>> islandPopulations(islands);
 
 	int popSize = static_cast<int>(population.size());
@@ -71,7 +72,7 @@ void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &populati
 	}
 
 	for (auto org : population) {
-		islandPopulations[org->dataMap.getIntVector("IsOp_island")[0]].push_back(org);
+		islandPopulations[org->dataMap.getFirstInt(islandKey)].push_back(org);
 	}
 
 	population.clear();
@@ -129,7 +130,7 @@ void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &populati
 	// fillerKeys tells us for each island what we need to add
 	// fillerLookup tells us the type of the data that we need to add (0 = number, 1 = string)
 	for (auto org : population) {
-		for (auto key : fillerKeys[org->dataMap.getIntVector("IsOp_island")[0]]) {
+		for (auto key : fillerKeys[org->dataMap.getFirstInt(islandKey)]) {
 			if (fillerLookup[key] == 0) {
 				org->dataMap.set(key, 0);
 			}
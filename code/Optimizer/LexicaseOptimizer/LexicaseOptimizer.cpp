@@ -231,22 +231,25 @@ void LexicaseOptimizer::optimize(
   // generate new organisms
   // do not add to population until all have been
   // selected
-  newPopulation.clear();
-  newPopulation.reserve(nextPopulationTargetSize);
 
-  // generate a list of 'nextPopulationTargetSize' new orgs into 'newPopulation'
+  // generate a list of 'nextPopulationTargetSize' parent lists
   // for each, generate a 'parents' vector with 'numberParents' parent orgs
   // parents are selected with lexiSelect( m_choose_n(population.size(), poolSize))
   //   where the m_choose_n command selects 'poolSize' number of population indexes
+  std::vector<std::vector<std::shared_ptr<Organism>>> parentLists;
+  parentLists.reserve(nextPopulationTargetSize);
   std::generate_n(
-      std::back_inserter(newPopulation), nextPopulationTargetSize, [&] {
+      std::back_inserter(parentLists), nextPopulationTargetSize, [&] {
         std::vector<std::shared_ptr<Organism>> parents;
         std::generate_n(std::back_inserter(parents), numberParents, [&] {
           return population[lexiSelect(m_choose_n(population.size(), poolSize))];
         });
-        return parents[0]->makeMutatedOffspringFromMany(parents);
+        return parents;
       });
 
+  // then make the new orgs (in parallel) into 'newPopulation'
+  newPopulation = makeMutatedOffspring(parentLists, true);
+
   oldPopulation = population;
   population.insert(population.end(), newPopulation.begin(), newPopulation.end());
   for (size_t fIndex = 0; fIndex < optimizeFormulasMTs.size(); fIndex++) {
@@ -86,12 +86,15 @@ void RouletteOptimizer::optimize(std::vector<std::shared_ptr<Organism>>& populat
 
 	killList.clear();
 
+	static const DataMap::Key optimizeValueKey("optimizeValue"),
+		remappedOptimizeValueKey("remappedOptimizeValue"),
+		numOffspringKey("roulette_numOffspring");
 	for (size_t i = 0; i < popSize; i++) {
 		killList.insert(population[i]);
 		double opVal = optimizeValueMT->eval(population[i]->dataMap, PT)[0];
 		scores[i] = opVal;
 		aveScore += opVal;
-		population[i]->dataMap.set("optimizeValue", opVal);
+		population[i]->dataMap.set(optimizeValueKey, opVal);
 		maxScore = std::max(maxScore, opVal);
 		minScore = std::min(minScore, opVal);
 	}
@@ -103,7 +106,7 @@ void RouletteOptimizer::optimize(std::vector<std::shared_ptr<Organism>>& populat
 		for (size_t i = 0; i < popSize; i++) {
 			remapVect[0][3] = scores[i];
 			remappedScores[i] = remapFunctionMT->eval(population[i]->dataMap, PT, remapVect)[0];
-			population[i]->dataMap.set("remappedOptimizeValue", remappedScores[i]);
+			population[i]->dataMap.set(remappedOptimizeValueKey, remappedScores[i]);
 		}
 	}
 	else {
@@ -114,24 +117,20 @@ void RouletteOptimizer::optimize(std::vector<std::shared_ptr<Organism>>& populat
 	double remappedScoresMax = *std::max_element(remappedScores.begin(), remappedScores.end());
 	double remappedScoresMin = *std::min_element(remappedScores.begin(), remappedScores.end());
 
-	std::vector<std::shared_ptr<Organism>> parents;
+	// select all parents first, then make the offspring (in parallel)
+	std::vector<std::vector<std::shared_ptr<Organism>>> parentLists(popSize);
 
 	for (int i = 0; i < popSize; i++) {
-		if (numberParents == 1) {
-			auto parent = population[selectParent(remappedScores, remappedScoresMax, remappedScoresMin, popSize)];
-			population.push_back(parent->makeMutatedOffspringFrom(parent)); // add to population
-		}
-		else {
-			parents.clear();
-			do {
-				parents.push_back(population[selectParent(remappedScores, remappedScoresMax, remappedScoresMin, popSize)]); // select from culled
-			} while (static_cast<int>(parents.size()) < numberParents);
-			population.push_back(parents[0]->makeMutatedOffspringFromMany(parents)); // push to population
-		}
-
+		auto &parents = parentLists[i];
+		do {
+			parents.push_back(population[selectParent(remappedScores, remappedScoresMax, remappedScoresMin, popSize)]); // select from culled
+		} while (static_cast<int>(parents.size()) < numberParents);
 	}
+
+	auto offspring = makeMutatedOffspring(parentLists, numberParents > 1);
+	population.insert(population.end(), offspring.begin(), offspring.end()); // add to population
 	for (int i = 0; i < popSize; i++) {
-		population[i]->dataMap.set("roulette_numOffspring", population[i]->offspringCount);
+		population[i]->dataMap.set(numOffspringKey, population[i]->offspringCount);
 	}
 	std::cout << "max = " << std::to_string(maxScore) << "   ave = " << std::to_string(aveScore) << "   min = " << std::to_string(minScore);
 }
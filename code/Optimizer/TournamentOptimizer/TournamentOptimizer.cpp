@@ -66,37 +66,36 @@ void TournamentOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &popul
 
 	killList.clear();
 
+	static const DataMap::Key optimizeValueKey("optimizeValue"),
+		numOffspringKey("tournament_numOffspring");
 	for (size_t i = 0; i < popSize; i++) {
 		killList.insert(population[i]);
 		double opVal = optimizeValueMT->eval(population[i]->dataMap, PT)[0];
 		scores[i] = opVal;
 		aveScore += opVal;
-		population[i]->dataMap.set("optimizeValue", opVal);
+		population[i]->dataMap.set(optimizeValueKey, opVal);
 		maxScore = std::max(maxScore, opVal);
 		minScore = std::min(minScore, opVal);
 	}
 	
 	aveScore /= popSize;
 
-	std::vector<std::shared_ptr<Organism>> parents;
+	// select all parents first, then make the offspring (in parallel)
+	std::vector<std::vector<std::shared_ptr<Organism>>> parentLists(popSize);
 
 	for (int i = 0; i < popSize; i++) {
-		if (numberParents == 1) {
-			auto parent = population[selectParent(tournamentSize, minimizeError, scores, popSize)];
-			population.push_back(parent->makeMutatedOffspringFrom(parent)); // add to population
-		}
-		else {
-			parents.clear();
-			parents.push_back(population[selectParent(tournamentSize, minimizeError, scores, popSize)]);
-			while (static_cast<int>(parents.size()) < numberParents) {
-				parents.push_back(population[selectParent(tournamentSize, minimizeError, scores, popSize)]); // select from culled
-			}
-			population.push_back(parents[0]->makeMutatedOffspringFromMany(parents)); // push to population
+		auto &parents = parentLists[i];
+		parents.push_back(population[selectParent(tournamentSize, minimizeError, scores, popSize)]);
+		while (static_cast<int>(parents.size()) < numberParents) {
+			parents.push_back(population[selectParent(tournamentSize, minimizeError, scores, popSize)]); // select from culled
 		}
 	}
 
+	auto offspring = makeMutatedOffspring(parentLists, numberParents > 1);
+	population.insert(population.end(), offspring.begin(), offspring.end()); // add to population
+
 	for (int i = 0; i < popSize; i++) {
-		population[i]->dataMap.set("tournament_numOffspring", population[i]->offspringCount);
+		population[i]->dataMap.set(numOffspringKey, population[i]->offspringCount);
 	}
 
 	if (!minimizeError) {
@@ -33,9 +33,34 @@ void Organism::initOrganism(std::shared_ptr<ParametersTable> PT_) {
   offspringCount = 0;           // because it's alive;
   timeOfBirth = Global::update; // happy birthday!
   timeOfDeath = -1;             // still alive
-  dataMap.set("ID", ID);
-  dataMap.set("alive", alive);
-  dataMap.set("timeOfBirth", timeOfBirth);
+  static const DataMap::Key IDKey("ID"), aliveKey("alive"),
+      timeOfBirthKey("timeOfBirth");
+  dataMap.set(IDKey, ID);
+  dataMap.set(aliveKey, alive);
+  dataMap.set(timeOfBirthKey, timeOfBirth);
+}
+
+// add stats from genomes and brains to dataMap
+void Organism::collectStats() {
+  for (auto genome : genomes) { // collect stats from genomes
+    std::string prefix;
+    (genome.first == "root::") ? prefix = "" : prefix = genome.first;
+    dataMap.merge(genome.second->getStats(prefix));
+  }
+
+  for (auto brain : brains) { // collect stats from brains
+    std::string prefix;
+    (brain.first == "root::") ? prefix = "" : prefix = brain.first;
+    dataMap.merge(brain.second->getStats(prefix));
+  }
+}
+
+void Organism::collectUpdateCacheStats() {
+  for (auto brain : brains) {
+    std::string prefix;
+    (brain.first == "root::") ? prefix = "" : prefix = brain.first;
+    dataMap.merge(brain.second->getUpdateCacheStats(prefix), 2);
+  }
 }
 
 /*
@@ -63,20 +88,8 @@ Organism::Organism(
   initOrganism(std::move(PT_));
 
   genomes = _genomes;
-
-  for (auto genome : genomes) { // collect stats from genomes
-    std::string prefix;
-    (genome.first == "root::") ? prefix = "" : prefix = genome.first;
-    dataMap.merge(genome.second->getStats(prefix));
-  }
-
   brains = _brains;
-
-  for (auto brain : _brains) { // collect stats from brains
-    std::string prefix;
-    (brain.first == "root::") ? prefix = "" : prefix = brain.first;
-    dataMap.merge(brain.second->getStats(prefix));
-  }
+  collectStats();
 
   ancestors.insert(ID); // it is it's own Ancestor for data tracking purposes
   snapshotAncestors.insert(ID);
@@ -96,20 +109,8 @@ Organism::Organism(
   initOrganism(std::move(PT_));
 
   genomes = _genomes;
-
-  for (auto genome : genomes) { // collect stats from genomes
-    std::string prefix;
-    (genome.first == "root::") ? prefix = "" : prefix = genome.first;
-    dataMap.merge(genome.second->getStats(prefix));
-  }
-
   brains = _brains;
-
-  for (auto brain : _brains) { // collect stats from brains
-    std::string prefix;
-    (brain.first == "root::") ? prefix = "" : prefix = brain.first;
-    dataMap.merge(brain.second->getStats(prefix));
-  }
+  collectStats();
 
   parents.push_back(from);
   from->offspringCount++; // this parent has an(other) offspring
@@ -137,20 +138,8 @@ Organism::Organism(
   initOrganism(std::move(PT_));
 
   genomes = _genomes;
-
-  for (auto genome : genomes) { // collect stats from genomes
-    std::string prefix;
-    (genome.first == "root::") ? prefix = "" : prefix = genome.first;
-    dataMap.merge(genome.second->getStats(prefix));
-  }
-
   brains = _brains;
-
-  for (auto brain : _brains) { // collect stats from brains
-    std::string prefix;
-    (brain.first == "root::") ? prefix = "" : prefix = brain.first;
-    dataMap.merge(brain.second->getStats(prefix));
-  }
+  collectStats();
 
   for (auto const &parent : from) {
     parents.push_back(parent); // add this parent to the parents set
@@ -194,37 +183,75 @@ void Organism::kill() {
 
 std::shared_ptr<Organism>
 Organism::makeMutatedOffspringFrom(std::shared_ptr<Organism> from) {
+  auto newOrg = makeOffspringFrom(from);
+  newOrg->inheritMutatedFrom(from);
+  return newOrg;
+}
+
+std::shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(
+    std::vector<std::shared_ptr<Organism>> from) {
+  auto newOrg = makeOffspringFromMany(from);
+  newOrg->inheritMutatedFromMany(from);
+  return newOrg;
+}
+
+/*
+ * create an offspring of "from" with no genomes or brains (these are added by
+ * inheritMutatedFrom). This sets the offspring's ID, lineage and the parents
+ * offspringCount, so offspring must be made one at a time.
+ */
+std::shared_ptr<Organism>
+Organism::makeOffspringFrom(std::shared_ptr<Organism> from) {
+  std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> newGenomes;
+  std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> newBrains;
+  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
+}
 
+std::shared_ptr<Organism>
+Organism::makeOffspringFromMany(std::vector<std::shared_ptr<Organism>> from) {
   std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> newGenomes;
   std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> newBrains;
+  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
+}
+
+/*
+ * fill in genomes (mutated copies of "from"s genomes) and brains of an
+ * organism made with makeOffspringFrom. Mutations are drawn from a stream
+ * belonging to this organism, so they do not depend on what else has used
+ * random numbers. Only this organism is changed (parents are only read) so
+ * many offspring can be built at the same time on different threads.
+ */
+void Organism::inheritMutatedFrom(std::shared_ptr<Organism> from) {
+  auto generator = Random::makeStream(
+      {Random::REPRODUCTION_STREAM, static_cast<uint64_t>(ID)});
+  Random::GeneratorScope useGenerator(generator);
 
   for (auto genome : from->genomes) {
-    newGenomes[genome.first] =
+    genomes[genome.first] =
         genome.second->makeMutatedGenomeFrom(genome.second);
   }
 
   for (auto brain : from->brains) {
-    newBrains[brain.first] =
-        brain.second->makeBrainFrom(brain.second, newGenomes);
-    newBrains[brain.first]->mutate();
+    brains[brain.first] = brain.second->makeBrainFrom(brain.second, genomes);
+    brains[brain.first]->mutate();
   }
 
-  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
+  collectStats();
 }
 
-std::shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(
+void Organism::inheritMutatedFromMany(
     std::vector<std::shared_ptr<Organism>> from) {
-
-  std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> newGenomes;
-  std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> newBrains;
+  auto generator = Random::makeStream(
+      {Random::REPRODUCTION_STREAM, static_cast<uint64_t>(ID)});
+  Random::GeneratorScope useGenerator(generator);
 
   for (auto genome : from[0]->genomes) {
     std::vector<std::shared_ptr<AbstractGenome>>
         parentGenomes; // make a list of parents genomes
     for (auto const &p : from) {
-      parentGenomes.push_back(p->genomes[genome.first]);
+      parentGenomes.push_back(p->genomes.at(genome.first));
     }
-    newGenomes[genome.first] =
+    genomes[genome.first] =
         genome.second->makeMutatedGenomeFromMany(parentGenomes);
   }
 
@@ -232,15 +259,14 @@ std::shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(
     std::vector<std::shared_ptr<AbstractBrain>>
         parentBrains; // make a list of parents genomes
     for (auto const &p : from) {
-      parentBrains.push_back(p->brains[brain.first]);
+      parentBrains.push_back(p->brains.at(brain.first));
     }
 
-    newBrains[brain.first] =
-        brain.second->makeBrainFromMany(parentBrains, newGenomes);
-    newBrains[brain.first]->mutate();
+    brains[brain.first] = brain.second->makeBrainFromMany(parentBrains, genomes);
+    brains[brain.first]->mutate();
   }
 
-  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
+  collectStats();
 }
 
 /*
@@ -336,3 +362,65 @@ Organism::makeCopy(std::shared_ptr<ParametersTable> PT_) {
   newOrg->alive = alive;
   return newOrg;
 }
+
+// ancestor sets are written in iteration order and rebuilt with the same
+// bucket count in reverse order, which gives back the same iteration order
+// (this keeps ancestor lists in data files the same after a restart)
+static void saveIDSet(CheckpointWriter &out, const std::unordered_set<int> &ids) {
+  out.put(static_cast<uint64_t>(ids.bucket_count()));
+  out.put(std::vector<int>(ids.begin(), ids.end()));
+}
+
+static void loadIDSet(CheckpointReader &in, std::unordered_set<int> &ids) {
+  auto bucketCount = in.get<uint64_t>();
+  std::vector<int> values;
+  in.get(values);
+  ids.clear();
+  ids.rehash(bucketCount);
+  for (auto id = values.rbegin(); id != values.rend(); ++id) {
+    ids.insert(*id);
+  }
+}
+
+void Organism::saveCheckpoint(CheckpointWriter &out) {
+  out.put(ID);
+  out.put(timeOfBirth);
+  out.put(timeOfDeath);
+  out.put(alive);
+  out.put(trackOrganism);
+  out.put(offspringCount);
+  saveIDSet(out, ancestors);
+  saveIDSet(out, snapshotAncestors);
+  dataMap.saveCheckpoint(out);
+  out.put(static_cast<uint64_t>(snapShotDataMaps.size()));
+  for (auto &snapShot : snapShotDataMaps) {
+    out.put(snapShot.first);
+    snapShot.second.saveCheckpoint(out);
+  }
+}
+
+void Organism::loadCheckpoint(CheckpointReader &in) {
+  in.get(ID);
+  in.get(timeOfBirth);
+  in.get(timeOfDeath);
+  in.get(alive);
+  in.get(trackOrganism);
+  in.get(offspringCount);
+  loadIDSet(in, ancestors);
+  loadIDSet(in, snapshotAncestors);
+  dataMap.loadCheckpoint(in);
+  snapShotDataMaps.clear();
+  auto count = in.get<uint64_t>();
+  for (uint64_t i = 0; i < count; i++) {
+    auto update = in.get<int>();
+    snapShotDataMaps[update].loadCheckpoint(in);
+  }
+}
+
+void Organism::saveIDCounter(CheckpointWriter &out) {
+  out.put(organismIDCounter);
+}
+
+void Organism::loadIDCounter(CheckpointReader &in) {
+  in.get(organismIDCounter);
+}
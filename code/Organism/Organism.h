@@ -24,9 +24,11 @@ class Organism {
 private:
   static int organismIDCounter; // used to issue unique ids to Genomes
   int registerOrganism();       // get an Organism_id (uses organismIDCounter)
+  void collectStats();          // merge genome and brain stats into dataMap
 
 public:
   DataMap dataMap; // holds all data (genome size, score, world data, etc.)
+  void collectUpdateCacheStats(); // merge brain update cache hits/misses into dataMap
   std::map<int, DataMap> snapShotDataMaps; // Used only with SnapShot with Delay
   // (SSwD) stores contents of dataMap when
   // an ouput interval is reached so that
@@ -107,7 +109,25 @@ public:
   makeMutatedOffspringFrom(std::shared_ptr<Organism> parent);
   virtual std::shared_ptr<Organism>
   makeMutatedOffspringFromMany(std::vector<std::shared_ptr<Organism>> from);
+  // makeMutatedOffspringFrom in two steps: makeOffspringFrom (serial, sets
+  // ID and lineage) then inheritMutatedFrom (only changes the new organism,
+  // may run on any thread). see AbstractOptimizer::makeMutatedOffspring
+  virtual std::shared_ptr<Organism>
+  makeOffspringFrom(std::shared_ptr<Organism> parent);
+  virtual std::shared_ptr<Organism>
+  makeOffspringFromMany(std::vector<std::shared_ptr<Organism>> from);
+  virtual void inheritMutatedFrom(std::shared_ptr<Organism> parent);
+  virtual void
+  inheritMutatedFromMany(std::vector<std::shared_ptr<Organism>> from);
   virtual std::shared_ptr<Organism>
   makeCopy(std::shared_ptr<ParametersTable> PT_ = nullptr);
+
+  // write/read this organism for a checkpoint (see GLOBAL-checkpointInterval).
+  // genomes and brains are handled by the caller, parents are not saved.
+  void saveCheckpoint(CheckpointWriter &out);
+  void loadCheckpoint(CheckpointReader &in);
+  // the ID the next organism will get
+  static void saveIDCounter(CheckpointWriter &out);
+  static void loadIDCounter(CheckpointReader &in);
 };
 
@@ -0,0 +1,78 @@
+#include <Genome/SiteEncoding.h>
+
+namespace {
+template <class T> std::vector<T> roundTrip(const std::vector<T> &sites) {
+	std::vector<T> decoded;
+	SiteEncoding::decode(SiteEncoding::encode<T>(sites), decoded, "test");
+	return decoded;
+}
+
+// encode() output with the header byte at index changed to value
+std::string withHeaderByte(const std::string &text, size_t index, char value) {
+	std::string bytes;
+	SiteEncoding::fromBase64(text.data() + SiteEncoding::prefix.size(),
+	                         text.size() - SiteEncoding::prefix.size(), bytes);
+	bytes[index] = value;
+	return SiteEncoding::prefix + SiteEncoding::toBase64(bytes);
+}
+}
+
+TEST(SiteEncoding, Base64RoundTripsEveryLength) {
+	std::string bytes;
+	for (int n = 0; n < 12; n++) { // lengths 0, 1 and 2 (mod 3)
+		std::string text = SiteEncoding::toBase64(bytes);
+		EXPECT_EQ(text.size() % 4, 0) << "n = " << n;
+		std::string decoded;
+		EXPECT_TRUE(SiteEncoding::fromBase64(text.data(), text.size(), decoded));
+		EXPECT_EQ(decoded, bytes) << "n = " << n;
+		bytes += (char)(n * 37 + 200);
+	}
+}
+
+TEST(SiteEncoding, SitesRoundTrip) {
+	for (int n = 0; n < 4; n++) { // 8 header bytes + n sites covers each length mod 3
+		std::vector<bool> bools;
+		std::vector<char> chars;
+		std::vector<int> ints;
+		std::vector<double> doubles;
+		for (int i = 0; i < n; i++) {
+			bools.push_back(i % 2 == 0);
+			chars.push_back((char)(i * 90 - 100));
+			ints.push_back(i * 1000003 - 7);
+			doubles.push_back(i * -1.25e300 + 0.1);
+		}
+		EXPECT_EQ(roundTrip(bools), bools) << "n = " << n;
+		EXPECT_EQ(roundTrip(chars), chars) << "n = " << n;
+		EXPECT_EQ(roundTrip(ints), ints) << "n = " << n;
+		EXPECT_EQ(roundTrip(doubles), doubles) << "n = " << n;
+	}
+	EXPECT_TRUE(SiteEncoding::isBinary(SiteEncoding::encode<int>(std::vector<int>())));
+	EXPECT_FALSE(SiteEncoding::isBinary("1,2,3"));
+}
+
+TEST(SiteEncoding, RejectsBadVersion) {
+	auto text = withHeaderByte(SiteEncoding::encode<int>(std::vector<int>{1, 2}), 0, 2);
+	std::vector<int> sites;
+	EXPECT_EXIT(SiteEncoding::decode(text, sites, "test"), ::testing::ExitedWithCode(1), "");
+}
+
+TEST(SiteEncoding, RejectsWrongKind) {
+	auto text = SiteEncoding::encode<int>(std::vector<int>{1, 2});
+	std::vector<unsigned int> unsignedSites; // same size, other kind
+	EXPECT_EXIT(SiteEncoding::decode(text, unsignedSites, "test"), ::testing::ExitedWithCode(1), "");
+	std::vector<double> doubleSites;
+	EXPECT_EXIT(SiteEncoding::decode(text, doubleSites, "test"), ::testing::ExitedWithCode(1), "");
+	auto relabeled = withHeaderByte(text, 2, 'f');
+	std::vector<int> intSites;
+	EXPECT_EXIT(SiteEncoding::decode(relabeled, intSites, "test"), ::testing::ExitedWithCode(1), "");
+}
+
+TEST(SiteEncoding, RejectsNonBase64) {
+	std::string bytes;
+	EXPECT_FALSE(SiteEncoding::fromBase64("QUJD*A==", 8, bytes));
+	EXPECT_FALSE(SiteEncoding::fromBase64("QU JD", 5, bytes));
+	std::vector<int> sites;
+	EXPECT_EXIT(SiteEncoding::decode("b64:QUJD!EFB", sites, "test"), ::testing::ExitedWithCode(1), "");
+	EXPECT_EXIT(SiteEncoding::decode("b64:QUJD", sites, "test"), ::testing::ExitedWithCode(1), "")
+	    << "shorter than the header";
+}
@@ -0,0 +1,141 @@
+#include <Genome/CircularGenome/SiteStore.h>
+
+#include <numeric>
+
+namespace {
+const size_t page = SiteStore<int>::pageSize;
+
+std::vector<int> counting(size_t n, int from = 0) {
+	std::vector<int> values(n);
+	std::iota(values.begin(), values.end(), from);
+	return values;
+}
+
+std::vector<int> contents(const SiteStore<int> &store) {
+	return store.slice(0, store.size());
+}
+}
+
+TEST(SiteStore, WriteToSharedPageLeavesCopyAlone) {
+	SiteStore<int> a;
+	a.assign(counting(page * 2 + 5));
+	auto b = a;
+	b.set(3, -1);
+	b.set(page + 3, -2);
+	EXPECT_EQ(a[3], 3) << "set on a copy should not change the original";
+	EXPECT_EQ(a[page + 3], page + 3);
+	EXPECT_EQ(b[3], -1);
+	EXPECT_EQ(b[page + 3], -2);
+	a.push_back(99); // writes to the last page, which b still shares
+	EXPECT_EQ(b.size(), page * 2 + 5);
+	EXPECT_EQ(a[page * 2 + 5], 99);
+	EXPECT_EQ(contents(b)[page * 2 + 4], page * 2 + 4);
+}
+
+TEST(SiteStore, TruncatedSharedPageIsCopiedOnWrite) {
+	SiteStore<int> a;
+	a.assign(counting(page + 10));
+	auto b = a;
+	b.resize(page + 4); // b's last page is still a's, partly used
+	b.push_back(-1);
+	EXPECT_EQ(b[page + 4], -1);
+	EXPECT_EQ(a[page + 4], page + 4) << "a's last page should not change";
+	EXPECT_EQ(contents(a), counting(page + 10));
+}
+
+TEST(SiteStore, InsertAndEraseAcrossPages) {
+	SiteStore<int> store;
+	std::vector<int> expected = counting(page * 3);
+	store.assign(expected);
+	auto original = store;
+
+	auto values = counting(page + 7, 1000);
+	store.insert(page - 3, values);
+	expected.insert(expected.begin() + (page - 3), values.begin(), values.end());
+	EXPECT_EQ(contents(store), expected);
+
+	store.erase(page / 2, page * 2);
+	expected.erase(expected.begin() + page / 2, expected.begin() + page / 2 + page * 2);
+	EXPECT_EQ(contents(store), expected);
+
+	store.insert(store.size(), {7, 8}); // at the end
+	expected.insert(expected.end(), {7, 8});
+	store.erase(0, 1);
+	expected.erase(expected.begin());
+	EXPECT_EQ(contents(store), expected);
+
+	EXPECT_EQ(contents(original), counting(page * 3)) << "copy should not change";
+}
+
+TEST(SiteStore, ResizeAndAssign) {
+	SiteStore<int> store;
+	EXPECT_TRUE(store.empty());
+	store.assign(counting(page + 1));
+	EXPECT_EQ(store.size(), page + 1);
+	EXPECT_EQ(contents(store), counting(page + 1));
+
+	store.resize(page * 2 + 3);
+	auto expected = counting(page + 1);
+	expected.resize(page * 2 + 3);
+	EXPECT_EQ(contents(store), expected) << "new sites should be T()";
+
+	store.resize(5);
+	EXPECT_EQ(contents(store), counting(5));
+	store.resize(page + 2); // grows over the sites removed above
+	expected = counting(5);
+	expected.resize(page + 2);
+	EXPECT_EQ(contents(store), expected);
+
+	store.assign({});
+	EXPECT_TRUE(store.empty());
+	store.assign(counting(page));
+	EXPECT_EQ(contents(store), counting(page));
+}
+
+TEST(SiteStore, CopyTo) {
+	for (size_t n : {size_t(0), size_t(1), page - 1, page, page + 1, page * 3 + 17}) {
+		SiteStore<int> store;
+		store.assign(counting(n));
+		std::vector<int> out(n + 1, -1);
+		store.copyTo(out.data());
+		EXPECT_EQ(std::vector<int>(out.begin(), out.begin() + n), counting(n)) << "n = " << n;
+		EXPECT_EQ(out[n], -1) << "copyTo should write only size() sites, n = " << n;
+	}
+}
+
+TEST(SiteStore, AppendSharesOrCopies) {
+	SiteStore<int> from;
+	from.assign(counting(page * 2 + 9));
+	SiteStore<int> whole;
+	whole.append(from, 0, from.size());
+	whole.set(0, -1);
+	EXPECT_EQ(from[0], 0);
+
+	SiteStore<int> part;
+	part.append(from, page - 2, page + 5);
+	EXPECT_EQ(contents(part), counting(7, page - 2));
+}
+
+TEST(SiteStore, EditsInPlaceWhenNotShared) {
+	SiteStore<int> store;
+	std::vector<int> expected = counting(page * 4 + 3);
+	store.assign(expected);
+	for (size_t i = 0; i < 20; i++) {
+		size_t at = (i * 97) % store.size();
+		auto values = counting(i * 13 % (page + 9), -500);
+		store.insert(at, values);
+		expected.insert(expected.begin() + at, values.begin(), values.end());
+		size_t length = std::min(expected.size() - at, (i * 31) % (page * 2));
+		store.erase(at, length);
+		expected.erase(expected.begin() + at, expected.begin() + at + length);
+		ASSERT_EQ(contents(store), expected) << "i = " << i;
+	}
+
+	SiteStore<bool> bools; // std::vector<bool> has no data()
+	bools.assign(std::vector<bool>(page + 5, true));
+	bools.insert(page - 1, {false, false, false});
+	bools.erase(0, 2);
+	EXPECT_EQ(bools.size(), page + 6);
+	EXPECT_FALSE(bools[page - 3]);
+	EXPECT_TRUE(bools[page]);
+}
@@ -0,0 +1,61 @@
+#include <Brain/UpdateCache.h>
+
+#include <memory>
+
+TEST(UpdateCache, ThresholdDelaysReuse) {
+	UpdateCache cache(4, 2);
+	std::vector<double> key = {1, 0}, result = {0, 1};
+	EXPECT_EQ(cache.find(key), nullptr);
+	cache.store(key, result);
+	EXPECT_EQ(cache.find(key), nullptr) << "key has only been run once";
+	cache.store(key, {5, 5});
+	ASSERT_NE(cache.find(key), nullptr);
+	EXPECT_EQ(*cache.find(key), result) << "the first result should be kept";
+	EXPECT_EQ(cache.hits, 2);
+	EXPECT_EQ(cache.misses, 2);
+}
+
+TEST(UpdateCache, EvictsLeastRecentlyUsed) {
+	UpdateCache cache(2);
+	cache.store({1}, {10});
+	cache.store({2}, {20});
+	ASSERT_NE(cache.find({1}), nullptr); // {2} is now least recently used
+	cache.store({3}, {30});
+	EXPECT_EQ(cache.find({2}), nullptr) << "{2} should have been dropped";
+	ASSERT_NE(cache.find({1}), nullptr);
+	ASSERT_NE(cache.find({3}), nullptr);
+	EXPECT_EQ(*cache.find({3}), std::vector<double>({30}));
+	cache.store({4}, {40}); // {1} is now least recently used
+	EXPECT_EQ(cache.find({1}), nullptr) << "{1} should have been dropped";
+	EXPECT_NE(cache.find({3}), nullptr);
+	EXPECT_NE(cache.find({4}), nullptr);
+}
+
+TEST(UpdateCache, CopyOutlivesSource) {
+	auto source = std::make_unique<UpdateCache>(2);
+	source->store({1}, {10});
+	source->store({2}, {20});
+	UpdateCache copy(*source);
+	UpdateCache assigned;
+	assigned = *source;
+	source.reset();
+	for (auto cache : {&copy, &assigned}) {
+		ASSERT_NE(cache->find({1}), nullptr);
+		EXPECT_EQ(*cache->find({1}), std::vector<double>({10}));
+		cache->store({3}, {30}); // evicts {2}, through the copy's own list
+		EXPECT_EQ(cache->find({2}), nullptr);
+		EXPECT_NE(cache->find({3}), nullptr);
+	}
+}
+
+TEST(UpdateCache, EmptyCopyKeepsCapacity) {
+	UpdateCache cache(1, 1);
+	cache.store({1}, {10});
+	auto empty = cache.emptyCopy();
+	EXPECT_TRUE(empty.enabled());
+	EXPECT_EQ(empty.find({1}), nullptr);
+	empty.store({2}, {20});
+	empty.store({3}, {30});
+	EXPECT_EQ(empty.find({2}), nullptr) << "capacity 1 should be kept";
+	EXPECT_NE(empty.find({3}), nullptr);
+}
@@ -2,6 +2,9 @@
 #include <iostream>
 
 #include "test_graycode.h"
+#include "test_siteencoding.h"
+#include "test_sitestore.h"
+#include "test_updatecache.h"
 
 int main(int argc, char* argv[]) {
 	testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,128 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// Binary checkpoint files (see GLOBAL-checkpointInterval and the -r command
+// line option). A CheckpointWriter writes values in order and a
+// CheckpointReader reads them back in the same order. Values are written raw
+// (host byte order), strings and vectors are prefixed with their size, so a
+// checkpoint is only meant to be read by the same build of MABE that wrote it.
+//
+// section(name) writes a marker that the reader checks, so that a reader
+// that gets out of step with the writer stops with a useful message instead
+// of reading garbage.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class CheckpointWriter {
+public:
+  explicit CheckpointWriter(const std::string &fileName)
+      : out(fileName, std::ios::binary) {}
+
+  bool good() const { return out.good(); }
+  void close() { out.close(); }
+
+  template <class T> void put(const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "put() writes values as raw bytes");
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  void put(const std::string &value) {
+    put(static_cast<uint64_t>(value.size()));
+    out.write(value.data(), value.size());
+  }
+
+  template <class T> void put(const std::vector<T> &values) {
+    put(static_cast<uint64_t>(values.size()));
+    for (T value : values) // T, not auto, so vector<bool> works
+      put(value);
+  }
+
+  void section(const std::string &name) { put(name); }
+
+private:
+  std::ofstream out;
+};
+
+class CheckpointReader {
+public:
+  explicit CheckpointReader(const std::string &fileName)
+      : in(fileName, std::ios::binary), fileName(fileName) {}
+
+  bool good() const { return in.good(); }
+
+  template <class T> void get(T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "get() reads values as raw bytes");
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    check();
+  }
+
+  void get(std::string &value) {
+    uint64_t size;
+    get(size);
+    value.resize(size);
+    in.read(&value[0], size);
+    check();
+  }
+
+  template <class T> void get(std::vector<T> &values) {
+    uint64_t size;
+    get(size);
+    values.resize(size);
+    for (uint64_t i = 0; i < size; i++) {
+      T value;
+      get(value);
+      values[i] = value;
+    }
+  }
+
+  // read the same value that was written, for when the type is implied
+  template <class T> T get() {
+    T value;
+    get(value);
+    return value;
+  }
+
+  void section(const std::string &name) {
+    std::string found;
+    get(found);
+    if (found != name) {
+      std::cout << "  In CheckpointReader :: checkpoint file \"" << fileName
+                << "\" was expected to have section \"" << name
+                << "\" but has \"" << found
+                << "\". (was it written by a different build of MABE?)"
+                   "\n  exiting"
+                << std::endl;
+      exit(1);
+    }
+  }
+
+private:
+  std::ifstream in;
+  std::string fileName;
+
+  void check() {
+    if (!in) {
+      std::cout << "  In CheckpointReader :: checkpoint file \"" << fileName
+                << "\" ended early or could not be read.\n  exiting"
+                << std::endl;
+      exit(1);
+    }
+  }
+};
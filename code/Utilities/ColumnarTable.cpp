@@ -0,0 +1,293 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "ColumnarTable.h"
+
+#include <cstdlib>
+#include <cstring>
+
+const std::string ColumnarTable::extension = ".mbin";
+
+namespace {
+
+const char magic[8] = {'M', 'A', 'B', 'E', 'C', 'O', 'L', '\0'};
+
+// bools and ints are written the same way in csv files (0 and 1), so a
+// bool column can hold ints of 0 or 1 and an int column can hold bools.
+// any other change of type would not convert back to the csv text.
+bool isBoolOrInt(unsigned char type) {
+  return type == ColumnarTable::BOOL || type == ColumnarTable::INT;
+}
+
+bool isBoolOrIntList(unsigned char type) {
+  return type == ColumnarTable::BOOL_LIST || type == ColumnarTable::INT_LIST;
+}
+
+[[noreturn]] void notABool(const std::string &name, int64_t value) {
+  std::cout << "  In ColumnarTable :: column \"" << name
+            << "\" was started as type 'b' and can not hold the int " << value
+            << ".\n  exiting" << std::endl;
+  exit(1);
+}
+
+// the values are written as raw bytes (host byte order, little-endian on the
+// platforms MABE builds for)
+template <class T> void putRaw(std::string &out, T value) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  out.append(bytes, sizeof(T));
+}
+
+void putVarint(std::string &out, uint64_t value) {
+  while (value >= 0x80) {
+    out += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+// raw, or zigzag varints of differences if that is smaller. returns encoding
+unsigned char putInts(std::string &out, const std::vector<int64_t> &values) {
+  std::string varints;
+  int64_t previous = 0;
+  for (auto value : values) {
+    auto difference = static_cast<uint64_t>(value) - static_cast<uint64_t>(previous);
+    putVarint(varints, (difference << 1) ^ (0 - (difference >> 63)));
+    previous = value;
+  }
+  if (varints.size() < values.size() * sizeof(int64_t)) {
+    out += varints;
+    return 1;
+  }
+  for (auto value : values) {
+    putRaw(out, value);
+  }
+  return 0;
+}
+
+void putStrings(std::string &out, const std::vector<std::string> &values) {
+  for (auto const &value : values) {
+    putVarint(out, value.size());
+  }
+  for (auto const &value : values) {
+    out += value;
+  }
+}
+
+template <class T> bool getRaw(std::istream &in, T &value) {
+  char bytes[sizeof(T)];
+  if (!in.read(bytes, sizeof(T))) {
+    return false;
+  }
+  std::memcpy(&value, bytes, sizeof(T));
+  return true;
+}
+
+} // namespace
+
+bool ColumnarTable::isColumnarFile(const std::string &fileName) {
+  return fileName.size() >= extension.size() &&
+         fileName.compare(fileName.size() - extension.size(), extension.size(),
+                          extension) == 0;
+}
+
+ColumnarTable::Column &ColumnarTable::next(const std::string &name,
+                                           Type type) {
+  if (!schemaSet) {
+    columns.push_back({name, type, {}, {}, {}, {}});
+    nextColumn++;
+    return columns.back();
+  }
+  if (nextColumn >= columns.size() || columns[nextColumn].name != name) {
+    std::cout << "  In ColumnarTable :: column \"" << name
+              << "\" does not match the columns this file was started with. "
+                 "Rows of a binary data file must all have the same "
+                 "columns.\n  exiting"
+              << std::endl;
+    exit(1);
+  }
+  auto &column = columns[nextColumn++];
+  if (column.type != type &&
+      !(isBoolOrInt(column.type) && isBoolOrInt(type)) &&
+      !(isBoolOrIntList(column.type) && isBoolOrIntList(type))) {
+    std::cout << "  In ColumnarTable :: column \"" << name
+              << "\" was started as type '" << column.type
+              << "' and can not hold a value of type '" << type
+              << "'.\n  exiting" << std::endl;
+    exit(1);
+  }
+  return column;
+}
+
+void ColumnarTable::addInt(const std::string &name, Type type,
+                           int64_t value) {
+  auto &column = next(name, type);
+  if (column.type == BOOL && value != 0 && value != 1) {
+    notABool(name, value);
+  }
+  column.ints.push_back(value);
+}
+
+template <class T>
+void ColumnarTable::addNumbers(const std::string &name, Type type,
+                               const std::vector<T> &values) {
+  auto &column = next(name, type);
+  column.lengths.push_back(values.size());
+  for (T value : values) {
+    if (column.type == DOUBLE_LIST) {
+      column.doubles.push_back(static_cast<double>(value));
+    } else {
+      auto asInt = static_cast<int64_t>(value);
+      if (column.type == BOOL_LIST && asInt != 0 && asInt != 1) {
+        notABool(name, asInt);
+      }
+      column.ints.push_back(asInt);
+    }
+  }
+}
+
+void ColumnarTable::add(const std::string &name, bool value) {
+  addInt(name, BOOL, value);
+}
+
+void ColumnarTable::add(const std::string &name, int64_t value) {
+  addInt(name, INT, value);
+}
+
+void ColumnarTable::add(const std::string &name, double value) {
+  next(name, DOUBLE).doubles.push_back(value);
+}
+
+void ColumnarTable::add(const std::string &name, const std::string &value) {
+  next(name, STRING).strings.push_back(value);
+}
+
+void ColumnarTable::add(const std::string &name,
+                        const std::vector<bool> &values) {
+  addNumbers(name, BOOL_LIST, values);
+}
+
+void ColumnarTable::add(const std::string &name,
+                        const std::vector<int> &values) {
+  addNumbers(name, INT_LIST, values);
+}
+
+void ColumnarTable::add(const std::string &name,
+                        const std::vector<double> &values) {
+  addNumbers(name, DOUBLE_LIST, values);
+}
+
+void ColumnarTable::add(const std::string &name,
+                        const std::vector<std::string> &values) {
+  auto &column = next(name, STRING_LIST);
+  column.lengths.push_back(values.size());
+  column.strings.insert(column.strings.end(), values.begin(), values.end());
+}
+
+bool ColumnarTable::endRow() {
+  if (nextColumn != columns.size()) {
+    std::cout << "  In ColumnarTable :: a row has " << nextColumn
+              << " columns but this file has " << columns.size()
+              << ". Rows of a binary data file must all have the same "
+                 "columns.\n  exiting"
+              << std::endl;
+    exit(1);
+  }
+  schemaSet = true;
+  nextColumn = 0;
+  rowCount++;
+  return rowCount >= static_cast<int>(chunkRows);
+}
+
+void ColumnarTable::writeChunk(std::string &out) {
+  if (rowCount == 0) {
+    return;
+  }
+  if (!headerWritten) {
+    out.append(magic, sizeof(magic));
+    out += static_cast<char>(version);
+    putRaw(out, static_cast<uint32_t>(columns.size()));
+    for (auto const &column : columns) {
+      putRaw(out, static_cast<uint32_t>(column.name.size()));
+      out += column.name;
+      out += static_cast<char>(column.type);
+    }
+    headerWritten = true;
+  }
+  putRaw(out, static_cast<uint32_t>(rowCount));
+  std::string payload;
+  for (auto &column : columns) {
+    payload.clear();
+    unsigned char encoding = 0;
+    for (auto length : column.lengths) { // lists only
+      putVarint(payload, length);
+    }
+    switch (column.type) {
+    case BOOL:
+    case BOOL_LIST:
+      for (auto value : column.ints) {
+        payload += static_cast<char>(value);
+      }
+      break;
+    case INT:
+    case INT_LIST:
+      encoding = putInts(payload, column.ints);
+      break;
+    case DOUBLE:
+    case DOUBLE_LIST:
+      for (auto value : column.doubles) {
+        putRaw(payload, value);
+      }
+      break;
+    case STRING:
+    case STRING_LIST:
+      putStrings(payload, column.strings);
+      break;
+    }
+    out += static_cast<char>(encoding);
+    putRaw(out, static_cast<uint32_t>(payload.size()));
+    out += payload;
+    column.ints.clear();
+    column.doubles.clear();
+    column.strings.clear();
+    column.lengths.clear();
+  }
+  rowCount = 0;
+}
+
+bool ColumnarTable::readHeader(std::istream &in) {
+  char fileMagic[sizeof(magic)];
+  unsigned char fileVersion;
+  uint32_t count;
+  if (!in.read(fileMagic, sizeof(magic)) ||
+      std::memcmp(fileMagic, magic, sizeof(magic)) != 0 ||
+      !getRaw(in, fileVersion) || fileVersion != version ||
+      !getRaw(in, count)) {
+    return false;
+  }
+  columns.clear();
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t length;
+    unsigned char type;
+    if (!getRaw(in, length)) {
+      return false;
+    }
+    std::string name(length, '\0');
+    if (!in.read(&name[0], length) || !getRaw(in, type)) {
+      return false;
+    }
+    columns.push_back({name, static_cast<Type>(type), {}, {}, {}, {}});
+  }
+  schemaSet = true;
+  headerWritten = true;
+  nextColumn = 0;
+  rowCount = 0;
+  return true;
+}
@@ -0,0 +1,110 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// Columnar binary data files (.mbin, see ARCHIVIST_DEFAULT-format). A file holds the
+// same columns a csv file would, but values are stored typed, a column at a
+// time, in chunks of up to chunkRows rows. tools/mbin.py reads them (and
+// converts them back to the csv MABE would have written).
+//
+// All numbers are little-endian.
+//
+//   file   = "MABECOL" 0 | version (u8) | column count (u32)
+//            | for each column: name length (u32) | name | type (u8)
+//            | chunk*
+//   chunk  = row count (u32) | for each column: block
+//   block  = encoding (u8) | payload size in bytes (u32) | payload
+//
+// payload by column type:
+//   'b' bool    row count bytes (0 or 1)
+//   'i' int     encoding 0: int64 per row, encoding 1: varints (see below)
+//   'd' double  float64 per row
+//   's' string  varint byte length per row, then the bytes
+//   'B','I','D','S' lists of the above: varint element count per row, then
+//               the elements of every row as for the single value type
+//
+// encoding 1 stores each int as the zigzag varint of its difference from the
+// int before it (in the block), and is used when it is smaller.
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class ColumnarTable {
+public:
+  enum Type : unsigned char {
+    BOOL = 'b',
+    INT = 'i',
+    DOUBLE = 'd',
+    STRING = 's',
+    BOOL_LIST = 'B',
+    INT_LIST = 'I',
+    DOUBLE_LIST = 'D',
+    STRING_LIST = 'S'
+  };
+
+  static const std::string extension; // ".mbin"
+  static const unsigned char version = 1;
+  static const uint32_t chunkRows = 4096;
+
+  // true if fileName should be written as a columnar table
+  static bool isColumnarFile(const std::string &fileName);
+
+  // add the value of the next column of the current row. the first row sets
+  // the names and types of the columns, later rows must have the same names
+  // and types (except that bool and int columns can hold each other's values
+  // while they are 0 or 1, since csv files write both the same way). exits
+  // if a value does not fit its column.
+  void add(const std::string &name, bool value);
+  void add(const std::string &name, int64_t value);
+  void add(const std::string &name, double value);
+  void add(const std::string &name, const std::string &value);
+  void add(const std::string &name, const std::vector<bool> &values);
+  void add(const std::string &name, const std::vector<int> &values);
+  void add(const std::string &name, const std::vector<double> &values);
+  void add(const std::string &name, const std::vector<std::string> &values);
+
+  // finish the current row, returns true if a chunk is full
+  bool endRow();
+
+  int rows() const { return rowCount; }
+
+  // append the rows added so far as a chunk to out (after the file header, if
+  // this is the first chunk of the file) and start a new chunk
+  void writeChunk(std::string &out);
+
+  // read the header of a file this table is continuing (after a restart), so
+  // that rows are checked against it and no second header is written
+  bool readHeader(std::istream &in);
+
+private:
+  struct Column {
+    std::string name;
+    Type type;
+    std::vector<int64_t> ints;    // BOOL, INT and their lists
+    std::vector<double> doubles;  // DOUBLE, DOUBLE_LIST
+    std::vector<std::string> strings; // STRING, STRING_LIST
+    std::vector<uint32_t> lengths;    // lists, elements per row
+  };
+
+  std::vector<Column> columns;
+  bool headerWritten = false;
+  bool schemaSet = false; // columns is complete (first row done or read)
+  size_t nextColumn = 0;
+  int rowCount = 0;
+
+  Column &next(const std::string &name, Type type);
+  void addInt(const std::string &name, Type type, int64_t value);
+  template <class T>
+  void addNumbers(const std::string &name, Type type,
+                  const std::vector<T> &values);
+};
@@ -9,85 +9,577 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 #include "Data.h"
+#include "Filesystem.h"
 
+#include <algorithm>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <tuple>
 
 
 // global variables that should be accessible to all
 // set<string> FileManager::dataFilesCreated;
 
 std::string FileManager::outputPrefix;
-std::map<std::string, std::vector<std::string>> FileManager::fileColumns;
-std::map<std::string, std::ofstream>
-    FileManager::files; // list of files (NAME,ofstream)
-std::map<std::string, bool>
-    FileManager::fileStates; // list of files states (NAME,open?)
+std::map<std::string, FileManager::OutputFile>
+    FileManager::files; // list of files (NAME,file)
+std::recursive_mutex FileManager::fileMutex;
 std::map<std::string, int> DataMap::knownOutputBehaviors = {
     {"LIST", LIST},     {"AVE", AVE},     {"SUM", SUM}, {"PROD", PROD},
-    {"STDERR", STDERR}, {"FIRST", FIRST}, {"VAR", VAR}};
+    {"STDERR", STDERR}, {"FIRST", FIRST}, {"VAR", VAR},
+    {"MIN", MIN}, {"MAX", MAX}};
+
+// rows still in the buffer at exit are written out
+FileManager::OutputFile::~OutputFile() {
+  if (isOpen) {
+    flush();
+  }
+}
+
+// hand buffered rows to the stream and the stream's data to the OS
+void FileManager::OutputFile::flush(bool endChunk) {
+  if (table && endChunk) {
+    table->writeChunk(buffer);
+  }
+  stream.write(buffer.data(), buffer.size());
+  buffer.clear();
+  stream.flush();
+}
+
+FileManager::OutputFile &FileManager::getFile(const std::string &fileName) {
+  std::lock_guard<std::recursive_mutex> lock(fileMutex);
+  // rows usually go to the same file as the row before
+  static const std::string *lastName = nullptr;
+  static OutputFile *lastFile = nullptr;
+  if (lastName != nullptr && *lastName == fileName) {
+    return *lastFile;
+  }
+  auto found = files.find(fileName);
+  if (found == files.end()) {
+    found = files.emplace(std::piecewise_construct,
+                          std::forward_as_tuple(fileName),
+                          std::forward_as_tuple())
+                .first;
+    found->second.path = outputPrefix + fileName;
+    if (ColumnarTable::isColumnarFile(fileName)) {
+      found->second.table.reset(new ColumnarTable());
+    }
+  }
+  lastName = &found->first;
+  lastFile = &found->second;
+  return found->second;
+}
 
 void FileManager::writeToFile(const std::string &fileName,
                               const std::string &data,
                               const std::string &header) {
-  openFile(
-      fileName,
-      header); // make sure that the file is open and ready to be written to
-  files[fileName] << data << "\n" << std::flush;
-}
-
-void FileManager::openFile(const std::string &fileName, const std::string &header) {
-  if (files.find(fileName) ==
-      files.end()) { // if file has not be initialized yet
-    files.emplace(make_pair(fileName, std::ofstream())); // make an ofstream for the
-                                                    // new file and place in
-                                                    // FileManager::files
-    files[fileName].open(
-        std::string(outputPrefix) +
-        fileName);               // clear file contents and open in write mode
-    fileStates[fileName] = true; // this file is now open
+  std::lock_guard<std::recursive_mutex> lock(fileMutex);
+  writeToFile(getFile(fileName), data, header);
+}
+
+void FileManager::writeToFile(OutputFile &file, const std::string &data,
+                              const std::string &header) {
+  std::lock_guard<std::recursive_mutex> lock(fileMutex);
+  openFile(file,
+           header); // make sure that the file is open and ready to be written to
+  file.buffer += data;
+  file.buffer += '\n';
+  if (file.buffer.size() >= bufferSize) {
+    file.stream.write(file.buffer.data(), file.buffer.size());
+    file.buffer.clear();
+  }
+}
+
+void FileManager::openFile(OutputFile &file, const std::string &header) {
+  std::lock_guard<std::recursive_mutex> lock(fileMutex);
+  if (!file.created) { // if file has not be initialized yet
+    file.stream.open(file.path); // clear file contents and open in write mode
+    file.created = true;
+    file.isOpen = true; // this file is now open
     if (!header.empty()) { // if there is a header string, write this to the new
                            // file
-      files[fileName] << header << "\n";
+      file.buffer += header;
+      file.buffer += '\n';
     }
   }
-  if (fileStates[fileName] == false) { // if file is closed ...
-    files[fileName].open(std::string(outputPrefix) + fileName,
-                         std::ios::out |
-                             std::ios::app); // open file in append mode
+  if (!file.isOpen) { // if file is closed ...
+    file.stream.open(file.path,
+                     std::ios::out | std::ios::app); // open file in append mode
+    file.isOpen = true;
   }
 }
 
 void FileManager::closeFile(const std::string &fileName) {
-  if (files.find(fileName) == files.end()) {
+  std::lock_guard<std::recursive_mutex> lock(fileMutex);
+  auto found = files.find(fileName);
+  if (found == files.end() || !found->second.created) {
     std::cout << "  In FileManager::closeFile :: ERROR, attempt to close file '"
          << fileName
          << "' but this file has not been opened or created! Exiting." << std::endl;
     exit(1);
   }
-  files[fileName].close();
-  fileStates[fileName] = false; // make a note that this file is closed
+  auto &file = found->second;
+  if (file.isOpen) {
+    file.flush();
+    file.stream.close();
+  }
+  file.isOpen = false; // make a note that this file is closed
+}
+
+void FileManager::endTableRow(OutputFile &file) {
+  std::lock_guard<std::recursive_mutex> lock(fileMutex);
+  if (file.table->endRow()) {
+    file.table->writeChunk(file.buffer);
+  }
+  if (file.buffer.size() >= bufferSize) {
+    file.stream.write(file.buffer.data(), file.buffer.size());
+    file.buffer.clear();
+  }
+}
+
+void FileManager::flushAll(bool endTableChunks) {
+  std::lock_guard<std::recursive_mutex> lock(fileMutex);
+  for (auto &file : files) {
+    if (file.second.isOpen) {
+      file.second.flush(endTableChunks);
+    }
+  }
+}
+
+void FileManager::saveCheckpoint(CheckpointWriter &out) {
+  std::lock_guard<std::recursive_mutex> lock(fileMutex);
+  flushAll();
+  out.section("FileManager");
+  uint64_t count = 0;
+  for (auto &file : files) {
+    count += file.second.created;
+  }
+  out.put(count);
+  for (auto &file : files) {
+    if (!file.second.created) {
+      continue;
+    }
+    std::ifstream onDisk(file.second.path, std::ios::binary | std::ios::ate);
+    out.put(file.first);
+    out.put(static_cast<int64_t>(onDisk ? (int64_t)onDisk.tellg() : 0));
+    out.put(file.second.columns);
+  }
+}
+
+void FileManager::loadCheckpoint(CheckpointReader &in) {
+  std::lock_guard<std::recursive_mutex> lock(fileMutex);
+  in.section("FileManager");
+  auto count = in.get<uint64_t>();
+  for (uint64_t i = 0; i < count; i++) {
+    auto &file = getFile(in.get<std::string>());
+    auto size = in.get<int64_t>();
+    if (!truncateFile(file.path, size)) {
+      std::cout << "  In FileManager::loadCheckpoint :: could not cut file '"
+                << file.path << "' back to " << size
+                << " bytes. Exiting." << std::endl;
+      exit(1);
+    }
+    // known but closed, so the next write appends without a header
+    if (file.isOpen) {
+      file.buffer.clear();
+      file.stream.close();
+    }
+    file.created = true;
+    file.isOpen = false;
+    in.get(file.columns);
+    if (file.table && size > 0) { // carry on after the header already written
+      std::ifstream onDisk(file.path, std::ios::binary);
+      if (!file.table->readHeader(onDisk)) {
+        std::cout << "  In FileManager::loadCheckpoint :: '" << file.path
+                  << "' is not a columnar data file. Exiting." << std::endl;
+        exit(1);
+      }
+    }
+  }
+}
+
+namespace {
+
+// the key names of every DataMap, by id
+struct KeyRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, int> ids;
+  std::deque<std::string> names; // deque, so names do not move when added
+};
+
+KeyRegistry &keyRegistry() {
+  static KeyRegistry registry;
+  return registry;
+}
+
+} // namespace
+
+int DataMap::keyID(const std::string &name) {
+  // most lookups are for names this thread has seen before, and need no lock
+  thread_local std::unordered_map<std::string, int> known;
+  auto found = known.find(name);
+  if (found != known.end()) {
+    return found->second;
+  }
+  auto &registry = keyRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto added = registry.ids.emplace(name, static_cast<int>(registry.names.size()));
+  if (added.second) {
+    registry.names.push_back(name);
+  }
+  known.emplace(name, added.first->second);
+  return added.first->second;
+}
+
+const std::string &DataMap::keyName(int id) {
+  auto &registry = keyRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.names[id];
+}
+
+void DataMap::wrongType(const char *function, int key) {
+  std::cout << "  in DataMap::" << function << " :: attempt to use " << function
+            << " with key \"" << keyName(key)
+            << "\" but this key is associated with type " << typeOf(key)
+            << "\n  exiting." << std::endl;
+  std::cout << "  (if type is NONE, then the key was not found in dataMap)"
+            << std::endl;
+  exit(1);
+}
+
+void DataMap::noValues(const char *function, int key) {
+  std::cout << "  in DataMap::" << function << " :: key \"" << keyName(key)
+            << "\" has no values.\n  exiting." << std::endl;
+  exit(1);
+}
+
+void DataMap::typeConflict(const char *function, int key,
+                           const std::string &value, const char *valueType,
+                           bool isVector) {
+  std::cout << "  ERROR :: a call to DataMap::" << function
+            << " was called where the key was "
+               "already in use with another type."
+            << std::endl;
+  if (isVector) {
+    std::cout << "  function was called with : key = \"" << keyName(key)
+              << "\" value is a vector of " << valueType << "." << std::endl;
+  } else {
+    std::cout << "  function was called with : key = \"" << keyName(key)
+              << "\" value = \"" << value << "\" where value is " << valueType
+              << "." << std::endl;
+  }
+  std::cout << "  but ... key is already associated with type " << typeOf(key)
+            << ". Exiting." << std::endl;
+  exit(1);
+}
+
+void DataMap::appendConflict(int key, const std::string &value,
+                             const char *valueType, bool isVector) {
+  if (isVector) {
+    std::cout << "  In DataMap::append :: attempt to append a vector of type "
+              << valueType << " to \"";
+  } else {
+    std::cout << "  In DataMap::append :: attempt to append value \"" << value
+              << "\" of type " << valueType << " to \"";
+  }
+  std::cout << keyName(key) << "\" but this key is already associated with "
+            << lookupDataMapTypeName(typeOf(key)) << ".\n  exiting."
+            << std::endl;
+  exit(1);
+}
+
+std::vector<std::string> DataMap::getKeys() {
+  std::vector<std::string> keys;
+  for (auto &entry : entries) {
+    if (entry.type != NONE && entry.outputBehavior != NO_OUTPUT) {
+      keys.push_back(keyName(entry.key));
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+std::vector<std::string> DataMap::getColumnNames() {
+  std::vector<std::pair<std::string, int>> keys; // name, output behavior
+  for (auto &entry : entries) {
+    if (entry.type != NONE) {
+      keys.emplace_back(keyName(entry.key), entry.outputBehavior);
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  std::vector<std::string> columnNames;
+  for (auto &key : keys) {
+    auto OB = key.second;
+    if (OB & AVE) {
+      columnNames.push_back(key.first + "_AVE");
+    }
+    if (OB & FIRST) {
+      columnNames.push_back(key.first);
+    }
+    if (OB & SUM) {
+      std::cout << "  WARNING OUTPUT METHOD SUM IS HAS YET TO BE WRITTEN!"
+                << std::endl;
+    }
+    if (OB & PROD) {
+      std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
+                << std::endl;
+    }
+    if (OB & STDERR) {
+      std::cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!"
+                << std::endl;
+    }
+    if (OB & LIST) {
+      columnNames.push_back(key.first + "_LIST");
+    }
+    // if (OB & NO_OUTPUT) do nothing...
+  }
+  return columnNames;
+}
+
+std::string DataMap::getStringOfVector(const std::string &key) {
+  std::string returnString = "";
+  auto entry = findEntry(keyID(key));
+  if (entry == nullptr || entry->type == NONE) {
+    std::cout << "  In DataMap::GetString() :: key \"" << key
+              << "\" is not in data map!\n  exiting." << std::endl;
+    exit(1);
+  }
+  if (entry->type == STRING || entry->type == STRINGSOLO) {
+    for (auto &e : std::get<std::vector<std::string>>(entry->value)) {
+      returnString += e + ",";
+    }
+  } else {
+    withNumbers(*entry, [&](const auto &values) {
+      for (auto e : values) {
+        if (entry->type == DOUBLE || entry->type == DOUBLESOLO) {
+          returnString += std::to_string(static_cast<double>(e)) + ",";
+        } else {
+          returnString += std::to_string(static_cast<int>(e)) + ",";
+        }
+      }
+      return 0.0;
+    });
+  }
+  if (returnString.size() > 2) { // if vector was not empty
+    returnString.pop_back();     // remove trailing ","
+  }
+  return returnString;
+}
+
+void DataMap::checkNumeric(const Entry *entry, int key,
+                           const std::string &what) {
+  auto type = entry ? entry->type : NONE;
+  if (type == STRING || type == STRINGSOLO) {
+    std::cout << "  in DataMap::" << what
+              << " attempt to use with vector of type "
+                 "string associated key \""
+              << keyName(key) << "\".\n  Cannot average strings!\n  Exiting."
+              << std::endl;
+    exit(1);
+  } else if (type == NONE) {
+    std::cout << "  in DataMap::" << what << " attempt to get "
+              << (what == "getVariance" ? "value" : "average")
+              << " from nonexistent key \"" << keyName(key) << "\".\n  Exiting."
+              << std::endl;
+    exit(1);
+  }
+}
+
+double DataMap::getAverage(const Key &key) {
+  auto entry = findEntry(key.id);
+  checkNumeric(entry, key.id, "getAverage");
+  return withNumbers(*entry, [](const auto &values) {
+    double returnValue = 0;
+    for (auto e : values) {
+      returnValue += (double)e;
+    }
+    if (values.size() > 1) {
+      returnValue /= values.size();
+    } // else vector is size 1, no div needed or vector is empty, returnValue
+      // will be 0
+    return returnValue;
+  });
+}
+
+double DataMap::getAverage(const std::string &key) {
+  return getAverage(Key(key));
 }
 
-// copy constructor
-DataMap::DataMap(std::shared_ptr<DataMap> source) {
-  boolData = source->boolData;
-  doubleData = source->doubleData;
-  intData = source->intData;
-  stringData = source->stringData;
-  for (auto entry : source->inUse) {
-    inUse[entry.first] = entry.second;
+double DataMap::getVariance(const std::string &key) {
+  int id = keyID(key);
+  auto entry = findEntry(id);
+  checkNumeric(entry, id, "getVariance");
+  return withNumbers(*entry, [](const auto &values) {
+    double averageValue(0);
+    double varianceValue(0);
+    for (auto e : values) {
+      averageValue += (double)e;
+    }
+    averageValue /= values.size();
+    for (auto e : values) {
+      varianceValue += ((double)e - averageValue) * ((double)e - averageValue);
+    }
+    if (values.size() > 0)
+      varianceValue /= values.size() - 1;
+    else
+      varianceValue = 0;
+    return varianceValue;
+  });
+}
+
+double DataMap::getSum(const Key &key) {
+  auto entry = findEntry(key.id);
+  checkNumeric(entry, key.id, "getAverage");
+  return withNumbers(*entry, [](const auto &values) {
+    double returnValue = 0;
+    for (auto e : values) {
+      returnValue += (double)e;
+    }
+    return returnValue;
+  });
+}
+
+double DataMap::getSum(const std::string &key) { return getSum(Key(key)); }
+
+double DataMap::getMin(const std::string &key) {
+  int id = keyID(key);
+  auto entry = findEntry(id);
+  checkNumeric(entry, id, "getMin");
+  return withNumbers(*entry, [](const auto &values) {
+    return values.size() ? static_cast<double>(
+                               *std::min_element(values.begin(), values.end()))
+                         : 0.0;
+  });
+}
+
+double DataMap::getMax(const std::string &key) {
+  int id = keyID(key);
+  auto entry = findEntry(id);
+  checkNumeric(entry, id, "getMax");
+  return withNumbers(*entry, [](const auto &values) {
+    return values.size() ? static_cast<double>(
+                               *std::max_element(values.begin(), values.end()))
+                         : 0.0;
+  });
+}
+
+void DataMap::saveCheckpoint(CheckpointWriter &out) {
+  out.put(static_cast<uint64_t>(entries.size()));
+  for (auto &entry : entries) {
+    out.put(keyName(entry.key));
+    out.put(static_cast<int>(entry.type));
+    out.put(entry.outputBehavior);
+    switch (entry.type) {
+    case BOOL:
+    case BOOLSOLO:
+      out.put(copyOf<bool>(entry));
+      break;
+    case DOUBLE:
+    case DOUBLESOLO:
+      out.put(copyOf<double>(entry));
+      break;
+    case INT:
+    case INTSOLO:
+      out.put(copyOf<int>(entry));
+      break;
+    case STRING:
+    case STRINGSOLO:
+      out.put(copyOf<std::string>(entry));
+      break;
+    default:
+      break;
+    }
   }
-  // inUse = source->inUse; // replaced with for loop.
-  outputBehavior = source->outputBehavior;
 }
 
+void DataMap::loadCheckpoint(CheckpointReader &in) {
+  clearMap();
+  auto count = in.get<uint64_t>();
+  for (uint64_t i = 0; i < count; i++) {
+    auto &entry = findOrAddEntry(keyID(in.get<std::string>()));
+    entry.type = static_cast<dataMapType>(in.get<int>());
+    entry.outputBehavior = in.get<int>();
+    switch (entry.type) {
+    case BOOL:
+    case BOOLSOLO:
+      entry.value = in.get<std::vector<bool>>();
+      break;
+    case DOUBLE:
+    case DOUBLESOLO:
+      entry.value = in.get<std::vector<double>>();
+      break;
+    case INT:
+    case INTSOLO:
+      entry.value = in.get<std::vector<int>>();
+      break;
+    case STRING:
+    case STRINGSOLO:
+      entry.value = in.get<std::vector<std::string>>();
+      break;
+    default:
+      break;
+    }
+    // solo values go back inline (copied out first, as assigning destroys
+    // the vector they are in)
+    if (entry.type == BOOLSOLO) {
+      bool value = std::get<std::vector<bool>>(entry.value)[0];
+      entry.value = value;
+    } else if (entry.type == DOUBLESOLO) {
+      double value = std::get<std::vector<double>>(entry.value)[0];
+      entry.value = value;
+    } else if (entry.type == INTSOLO) {
+      int value = std::get<std::vector<int>>(entry.value)[0];
+      entry.value = value;
+    }
+  }
+}
 
 // take two strings (header and data), and a list of keys, and whether or not to
 // save "{LIST}"s. convert data from data map to header and data strings
+DataMap::Entry &DataMap::fileOutputBehavior(const std::string &i,
+                                            unsigned int &OB, bool aveOnly) {
+  auto entry = findEntry(keyID(i));
+  if (entry == nullptr || entry->type == NONE) {
+    std::cout << "  in DataMap::writeToFile() - key \"" << i
+         << "\" can not be found in data map!\n  exiting." << std::endl;
+    exit(1);
+  }
+  auto typeOfKey = entry->type;
+
+  // the following code makes use of bit masks! in short, AVE,SUM,LIST,etc
+  // each use only one bit of an int.
+  // therefore if we apply that mask the the outputBehavior, we can see if
+  // that type of output is needed.
+
+  OB = entry->outputBehavior;
+
+  if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
+    if (!(OB == LIST || OB == FIRST || OB == NO_OUTPUT)) {
+		std::cout << std::endl << OB << std::endl;
+      std::cout << "  in constructHeaderAndDataStrings :: attempt to write "
+              "string not in either LIST or FIRST formatte. This is not "
+              "allowed! Key was '" << i << "'. Exiting..."
+           << std::endl;
+      exit(1);
+    }
+  }
+
+  if (aveOnly) {
+	  if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
+		  OB = NO_OUTPUT;
+	  }
+	  else {
+		  OB &= (AVE | FIRST); // if aveOnly, only output AVE on the entries
+							 // that have been set for AVE
+	  }
+  }
+  return *entry;
+}
+
 void DataMap::constructHeaderAndDataStrings(std::string &headerStr, std::string &dataStr,
                                             const std::vector<std::string> &keys,
                                             bool aveOnly) {
@@ -97,86 +589,50 @@ void DataMap::constructHeaderAndDataStrings(std::string &headerStr, std::string
   unsigned int OB; // holds output behavior so it can be over ridden for ave file output!
   if (!keys.empty()) { // if keys is not empty
     for (auto const &i : keys) {
-      typeOfKey = findKeyInData(i);
-      if (typeOfKey == NONE) {
-        std::cout << "  in DataMap::writeToFile() - key \"" << i
-             << "\" can not be found in data map!\n  exiting." << std::endl;
-        exit(1);
-      }
-
-      // the following code makes use of bit masks! in short, AVE,SUM,LIST,etc
-      // each use only one bit of an int.
-      // therefore if we apply that mask the the outputBehavior, we can see if
-      // that type of output is needed.
-
-      OB = outputBehavior[i];
-
-      if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-        if (!(OB == LIST || OB == FIRST || OB == NO_OUTPUT)) {
-			std::cout << std::endl << OB << std::endl;
-          std::cout << "  in constructHeaderAndDataStrings :: attempt to write "
-                  "string not in either LIST or FIRST formatte. This is not "
-                  "allowed! Key was '" << i << "'. Exiting..."
-               << std::endl;
-          exit(1);
-        }
-      } 
-
-      if (aveOnly) {
-		  if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-			  OB = NO_OUTPUT;
-		  }
-		  else {
-			  OB &= (AVE | FIRST); // if aveOnly, only output AVE on the entries
-								 // that have been set for AVE
-		  }
-      }
+      auto &entry = fileOutputBehavior(i, OB, aveOnly);
+      typeOfKey = entry.type;
 
       if (OB & FIRST) { // save first (only?) element in vector with key as
                         // column name
         headerStr += FileManager::separator + i;
+        bool found = false;
         if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-          if (!getBoolVector(i).empty()) {
-            dataStr += FileManager::separator + to_string(getBoolVector(i)[0]);
+          bool value;
+          if ((found = first(entry, value))) {
+            dataStr += FileManager::separator + std::to_string(static_cast<int>(value));
           } else {
             dataStr += '0';
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
           }
         }
         if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-          if (!getDoubleVector(i).empty()) {
-            dataStr +=
-                FileManager::separator + std::to_string(getDoubleVector(i)[0]);
+          double value;
+          if ((found = first(entry, value))) {
+            dataStr += FileManager::separator + std::to_string(value);
           } else {
             dataStr += '0';
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
           }
         }
         if (typeOfKey == INT || typeOfKey == INTSOLO) {
-          if (!getIntVector(i).empty()) {
-            dataStr +=
-                FileManager::separator + std::to_string(getIntVector(i)[0]);
+          int value;
+          if ((found = first(entry, value))) {
+            dataStr += FileManager::separator + std::to_string(value);
           } else {
             dataStr += '0';
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
           }
         }
         if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-          if (!getStringVector(i).empty()) {
-            dataStr += FileManager::separator + (std::string)"\"" + getStringVector(i)[0] + (std::string)"\"";
+          std::string value;
+          if ((found = first(entry, value))) {
+            dataStr += FileManager::separator + (std::string)"\"" + value + (std::string)"\"";
           } else {
             dataStr += (std::string)"\"0\"";
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
           }
         }
+        if (!found) {
+          std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
+                  "while getting value for FIRST with key \""
+               << i << "\" vector is empty!" << std::endl;
+        }
       }
       if (OB & AVE) { // key_AVE = ave of vector (will error if of type string!)
         headerStr += FileManager::separator + i + "_AVE";
@@ -190,6 +646,14 @@ void DataMap::constructHeaderAndDataStrings(std::string &headerStr, std::string
         headerStr += FileManager::separator + i + "_SUM";
         dataStr += FileManager::separator + std::to_string(getSum(i));
       }
+      if (OB & MIN) { // key_MIN = smallest value in vector
+        headerStr += FileManager::separator + i + "_MIN";
+        dataStr += FileManager::separator + std::to_string(getMin(i));
+      }
+      if (OB & MAX) { // key_MAX = largest value in vector
+        headerStr += FileManager::separator + i + "_MAX";
+        dataStr += FileManager::separator + std::to_string(getMax(i));
+      }
       if (OB & PROD) { // key_PROD = product of vector
         std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
              << std::endl;
@@ -207,6 +671,64 @@ void DataMap::constructHeaderAndDataStrings(std::string &headerStr, std::string
     dataStr.erase(dataStr.begin());     // clip off the leading separator
   }
 }
+void DataMap::appendToTable(ColumnarTable &table,
+                            const std::vector<std::string> &keys,
+                            bool aveOnly) {
+  unsigned int OB;
+  for (auto const &key : keys) {
+    auto &entry = fileOutputBehavior(key, OB, aveOnly);
+    auto typeOfKey = entry.type;
+    if (OB & FIRST) { // an empty vector is written as 0, as in csv files
+      if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
+        bool value = false;
+        first(entry, value);
+        table.add(key, value);
+      }
+      if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
+        double value = 0;
+        first(entry, value);
+        table.add(key, value);
+      }
+      if (typeOfKey == INT || typeOfKey == INTSOLO) {
+        int value = 0;
+        first(entry, value);
+        table.add(key, static_cast<int64_t>(value));
+      }
+      if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
+        std::string value = "0";
+        first(entry, value);
+        table.add(key, value);
+      }
+    }
+    if (OB & AVE) {
+      table.add(key + "_AVE", getAverage(key));
+    }
+    if (OB & VAR) {
+      table.add(key + "_VAR", getVariance(key));
+    }
+    if (OB & SUM) {
+      table.add(key + "_SUM", getSum(key));
+    }
+    if (OB & MIN) {
+      table.add(key + "_MIN", getMin(key));
+    }
+    if (OB & MAX) {
+      table.add(key + "_MAX", getMax(key));
+    }
+    if (OB & LIST) {
+      if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
+        table.add(key + "_LIST", copyOf<bool>(entry));
+      } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
+        table.add(key + "_LIST", copyOf<double>(entry));
+      } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
+        table.add(key + "_LIST", copyOf<int>(entry));
+      } else {
+        table.add(key + "_LIST", copyOf<std::string>(entry));
+      }
+    }
+  }
+}
+
 ///////////////////////////////////////
 // need to add support for output prefix directory
 // need to add support for population file name prefixes
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <array>
 #include <fstream>
 #include <iostream>
 #include <set>
@@ -17,32 +18,75 @@
 #include <sstream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <type_traits>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
 #include "Utilities.h"
+#include "Checkpoint.h"
+#include "ColumnarTable.h"
 
 class FileManager {
 public:
-  static std::map<std::string, std::vector<std::string>>
-      fileColumns;                     // list of files (NAME,LIST OF COLUMNS)
-  static std::map<std::string, std::ofstream> files;  // list of files (NAME,ofstream)
-  static std::map<std::string, bool> fileStates; // list of files states (NAME,open?)
+  // Rows written to a file are collected in buffer and handed to the stream
+  // when buffer reaches bufferSize, so writing a row is not a system call.
+  // Rows are only sure to be on disk after flushAll() (end of each update),
+  // closeFile() or the end of the run (columnar files hold rows back until a
+  // chunk is full, see ColumnarTable).
+  struct OutputFile {
+    std::string path;
+    std::vector<std::string> columns; // set by DataMap::writeToFile
+    std::ofstream stream;
+    std::string buffer;   // rows not handed to stream yet
+    // rows not in buffer yet, if this is a columnar (.mbin) file
+    std::unique_ptr<ColumnarTable> table;
+    bool created = false; // has the file been created (and header written)?
+    bool isOpen = false;
+
+    ~OutputFile();
+    void flush(bool endChunk = true); // endChunk: write a part full chunk too
+  };
+
+  static const size_t bufferSize = 1 << 20;
+
+  static std::map<std::string, OutputFile> files; // list of files (NAME,file)
 
   static std::string outputPrefix;
 
   static const char separator = ',';
 
+  // guards files (and the files in it). Files may be written from the archive
+  // thread (see GLOBAL-pipelineArchive) and the main thread at the same time.
+  static std::recursive_mutex fileMutex;
+
+  // the entry for fileName, made (but not created on disk) if it is new.
+  // entries are never removed, so the reference stays valid.
+  static OutputFile &getFile(const std::string &fileName);
+
   static void writeToFile(const std::string &fileName, const std::string &data,
                           const std::string &header = ""); // fileName, data, header
                                                       // - used when you want to
                                                       // output formatted data
                                                       // (i.e. genomes)
-  static void openFile(const std::string &fileName,
+  static void writeToFile(OutputFile &file, const std::string &data,
+                          const std::string &header = "");
+  static void openFile(OutputFile &file,
                        const std::string &header = ""); // open file and write header
                                                    // to file if file is new and
                                                    // header is provided
   static void closeFile(const std::string &fileName);   // close file
+  // call after adding a row to file.table
+  static void endTableRow(OutputFile &file);
+  // put every buffered row on disk. rows of a columnar file that do not fill
+  // a chunk yet are kept back unless endTableChunks is set
+  static void flushAll(bool endTableChunks = true);
+
+  // save/restore the files written so far (columns and length on disk). A
+  // restored file is cut back to its saved length and then appended to.
+  static void saveCheckpoint(CheckpointWriter &out);
+  static void loadCheckpoint(CheckpointReader &in);
 };
 
 class DataMap {
@@ -55,13 +99,44 @@ public:
     STDERR = 16,
     FIRST = 32,
     VAR = 64,
-	 NO_OUTPUT = 128
+	 NO_OUTPUT = 128,
+    MIN = 256,
+    MAX = 512
   };                               // 0 = do not save or default..?
-  std::map<std::string, int> outputBehavior; // Defines how each element should be written
-                                   // to file - if element not found, LIST
-                                   // (write out list) is used.
   static std::map<std::string, int> knownOutputBehaviors;
 
+  // Key names are interned: every name used with any DataMap gets a small
+  // integer id (shared by all DataMaps, never reused), and a DataMap stores
+  // ids rather than names. A Key holds the id of a name, so code that sets
+  // the same key for every organism can look the name up once.
+  class Key {
+  public:
+    explicit Key(const std::string &name) : id(keyID(name)) {}
+    int id;
+  };
+
+  // the id of name (added if name is new) and the name of an id
+  static int keyID(const std::string &name);
+  static const std::string &keyName(int id);
+
+  // A view of the values of a key, for reading them without a copy. A view
+  // is only good until the DataMap is changed. A solo value is viewed as a
+  // list of one. (bools are packed in a std::vector<bool>, so there is no
+  // view of them, use getFirstBool or getBoolVector)
+  template <class T> class Values {
+  public:
+    Values(const T *first, size_t count) : first(first), count(count) {}
+    const T *begin() const { return first; }
+    const T *end() const { return first + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T &operator[](size_t i) const { return first[i]; }
+
+  private:
+    const T *first;
+    size_t count;
+  };
+
 private:
   enum dataMapType {
     NONE = 0,
@@ -75,43 +150,232 @@ private:
     STRINGSOLO = 14
   }; // NONE = not found in this data map
 
-  std::unordered_map<std::string, std::vector<bool>> boolData;
-  std::unordered_map<std::string, std::vector<double>> doubleData;
-  std::unordered_map<std::string, std::vector<int>> intData;
-  std::unordered_map<std::string, std::vector<std::string>> stringData;
+  struct Entry {
+    int key;                 // interned id of the key name
+    dataMapType type = NONE; // NONE if the key has only an output behavior
+    int outputBehavior = 0;  // how this key should be written to file
+    // BOOLSOLO, DOUBLESOLO and INTSOLO values are held inline, lists and
+    // strings in a vector
+    std::variant<bool, int, double, std::vector<bool>, std::vector<int>,
+                 std::vector<double>, std::vector<std::string>>
+        value;
+  };
+
+  std::vector<Entry> entries; // one per key, in the order keys were added
+
+  inline Entry *findEntry(int key) {
+    for (auto &entry : entries) {
+      if (entry.key == key) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+  inline Entry &findOrAddEntry(int key) {
+    if (auto entry = findEntry(key)) {
+      return *entry;
+    }
+    entries.emplace_back();
+    entries.back().key = key;
+    return entries.back();
+  }
+  inline dataMapType typeOf(int key) {
+    auto entry = findEntry(key);
+    return entry ? entry->type : NONE;
+  }
+
+  // the types an entry holding T has as a list and as a solo value
+  template <class T> static constexpr dataMapType listType() {
+    return std::is_same<T, bool>::value
+               ? BOOL
+               : std::is_same<T, double>::value
+                     ? DOUBLE
+                     : std::is_same<T, int>::value ? INT : STRING;
+  }
+  template <class T> static constexpr dataMapType soloType() {
+    return static_cast<dataMapType>(listType<T>() + 10);
+  }
+  template <class T> static bool holds(dataMapType t) {
+    return t == listType<T>() || t == soloType<T>();
+  }
+  template <class T> static const char *typeName() {
+    return std::is_same<T, bool>::value
+               ? "bool"
+               : std::is_same<T, double>::value
+                     ? "double"
+                     : std::is_same<T, int>::value ? "int" : "string";
+  }
+
+  // turn a solo entry into a list (strings are always held in a list)
+  template <class T> static std::vector<T> &asList(Entry &entry) {
+    if constexpr (!std::is_same<T, std::string>::value) {
+      if (auto solo = std::get_if<T>(&entry.value)) {
+        entry.value = std::vector<T>({*solo});
+      }
+    }
+    return std::get<std::vector<T>>(entry.value);
+  }
+  // the values of entry as a list, moved out of entry if it holds a list
+  template <class T> static std::vector<T> takeList(Entry &entry) {
+    if (auto list = std::get_if<std::vector<T>>(&entry.value)) {
+      return std::move(*list);
+    }
+    return copyOf<T>(entry);
+  }
+  template <class T> static std::vector<T> copyOf(const Entry &entry) {
+    if constexpr (!std::is_same<T, std::string>::value) {
+      if (auto solo = std::get_if<T>(&entry.value)) {
+        return std::vector<T>({*solo});
+      }
+    }
+    return std::get<std::vector<T>>(entry.value);
+  }
+
+  // call f with the values of a bool, double or int entry (a solo value as a
+  // one element array) and return what f returns
+  template <class F> static double withNumbers(const Entry &entry, F f) {
+    switch (entry.type) {
+    case BOOLSOLO:
+      return f(std::array<bool, 1>({std::get<bool>(entry.value)}));
+    case DOUBLESOLO:
+      return f(std::array<double, 1>({std::get<double>(entry.value)}));
+    case INTSOLO:
+      return f(std::array<int, 1>({std::get<int>(entry.value)}));
+    case BOOL:
+      return f(std::get<std::vector<bool>>(entry.value));
+    case DOUBLE:
+      return f(std::get<std::vector<double>>(entry.value));
+    default:
+      return f(std::get<std::vector<int>>(entry.value));
+    }
+  }
+
+  // exits if entry (of key) can not be averaged, what names the caller
+  static void checkNumeric(const Entry *entry, int key,
+                           const std::string &what);
+  // the first value of entry, false if it has none
+  template <class T> static bool first(const Entry &entry, T &value) {
+    if constexpr (!std::is_same<T, std::string>::value) {
+      if (auto solo = std::get_if<T>(&entry.value)) {
+        value = *solo;
+        return true;
+      }
+    }
+    auto &list = std::get<std::vector<T>>(entry.value);
+    if (list.empty()) {
+      return false;
+    }
+    value = list[0];
+    return true;
+  }
+
+  // exit from function, as key is not in this map or does not hold T
+  void wrongType(const char *function, int key);
+  void noValues(const char *function, int key);
+  template <class T> Entry &checkedEntry(int key, const char *function) {
+    auto entry = findEntry(key);
+    if (entry == nullptr || !holds<T>(entry->type)) {
+      wrongType(function, key);
+    }
+    return *entry;
+  }
+  template <class T> Values<T> valuesOf(int key, const char *function) {
+    auto &entry = checkedEntry<T>(key, function);
+    if constexpr (!std::is_same<T, std::string>::value) {
+      if (auto solo = std::get_if<T>(&entry.value)) {
+        return Values<T>(solo, 1);
+      }
+    }
+    auto &list = std::get<std::vector<T>>(entry.value);
+    return Values<T>(list.data(), list.size());
+  }
+  template <class T> T firstOf(int key, const char *function) {
+    T value;
+    if (!first(checkedEntry<T>(key, function), value)) {
+      noValues(function, key);
+    }
+    return value;
+  }
+
+  void typeConflict(const char *function, int key, const std::string &value,
+                    const char *valueType, bool isVector);
+  void appendConflict(int key, const std::string &value,
+                      const char *valueType, bool isVector);
 
-  std::map<std::string, dataMapType>
-      inUse; // holds list of keys with type 1=bool, 2=double, 3=int, 4=string
+  template <class T> void setValue(int key, const T &value) {
+    auto &entry = findOrAddEntry(key);
+    if (entry.type != NONE && !holds<T>(entry.type)) {
+      std::stringstream ss;
+      ss << value;
+      typeConflict("set", key, ss.str(), typeName<T>(), false);
+    }
+    if constexpr (std::is_same<T, std::string>::value) {
+      entry.value = std::vector<std::string>({value});
+    } else {
+      entry.value = value;
+    }
+    entry.type = soloType<T>(); // since this is set with SET, it is a single value
+    entry.outputBehavior = FIRST;
+  }
+  template <class T> void setValues(int key, std::vector<T> values) {
+    auto &entry = findOrAddEntry(key);
+    if (entry.type != NONE && !holds<T>(entry.type)) {
+      typeConflict("set", key, "", typeName<T>(), true);
+    }
+    entry.value = std::move(values);
+    entry.type = listType<T>();
+    entry.outputBehavior =
+        std::is_same<T, std::string>::value ? LIST : (LIST | AVE);
+  }
+  // append a value to the end of vector associated with key. If key is not
+  // found, start a new vector for key
+  template <class T> void appendValue(int key, const T &value) {
+    auto &entry = findOrAddEntry(key);
+    if (entry.type == NONE) {
+      entry.value = std::vector<T>({value});
+    } else if (holds<T>(entry.type)) {
+      asList<T>(entry).push_back(value);
+    } else {
+      std::stringstream ss;
+      ss << value;
+      appendConflict(key, ss.str(), typeName<T>(), false);
+    }
+    entry.type = listType<T>(); // make sure it's list rather then a solo
+    entry.outputBehavior =
+        std::is_same<T, std::string>::value ? LIST : (LIST | AVE);
+  }
 
 public:
   DataMap() = default;
 
   // copy constructor
-  DataMap(std::shared_ptr<DataMap> source);
+  DataMap(std::shared_ptr<DataMap> source) : DataMap(*source) {}
+
+  // write/read every entry, with its type and output behavior
+  void saveCheckpoint(CheckpointWriter &out);
+  void loadCheckpoint(CheckpointReader &in);
 
   inline void setOutputBehavior(const std::string &key, int _outputBehavior) {
-    outputBehavior[key] = _outputBehavior;
+    findOrAddEntry(keyID(key)).outputBehavior = _outputBehavior;
   }
 
   // find key in this data map and return type (NONE = not found)
   inline dataMapType findKeyInData(const std::string &key, bool printType = false) {
+    auto typeOfKey = typeOf(keyID(key));
     if (printType) {
-      std::cout << key << "is of type " << inUse[key] << std::endl;
-    }
-    if (inUse.find(key) != inUse.end()) {
-      return inUse[key];
-    } else {
-      return NONE;
+      std::cout << key << "is of type " << typeOfKey << std::endl;
     }
+    return typeOfKey;
   }
 
   // find key in this data map and return type (NONE = not found)
   inline bool isKeySolo(const std::string &key) {
-    if (inUse.find(key) != inUse.end()) {
-      return ((findKeyInData(key) == BOOLSOLO) ||
-              (findKeyInData(key) == DOUBLESOLO) ||
-              (findKeyInData(key) == INTSOLO) ||
-              (findKeyInData(key) == STRINGSOLO));
+    auto typeOfKey = findKeyInData(key);
+    if (typeOfKey != NONE) {
+      return ((typeOfKey == BOOLSOLO) ||
+              (typeOfKey == DOUBLESOLO) ||
+              (typeOfKey == INTSOLO) ||
+              (typeOfKey == STRINGSOLO));
     } else {
       std::cout << "  ERROR :: in DataMap::isKeySolo, key name " << key
            << " is not defined in DataMap. Exiting!" << std::endl;
@@ -138,324 +402,133 @@ public:
     }
   }
 
-  // return vector of strings will all keys in this data map
-  inline std::vector<std::string> getKeys() {
-    std::vector<std::string> keys;
-    for (auto e : inUse) {
-		 if (outputBehavior[e.first] != NO_OUTPUT) keys.push_back(e.first); // just push back the whole key
-    }
-    return (keys);
-  }
+  // return vector of strings will all keys in this data map (sorted)
+  std::vector<std::string> getKeys();
 
   // set functions (bool,double,int,string) that take a **single** value -
   // either make new map entry or replace existing
   inline void set(const std::string &key, const bool &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == BOOL ||
-        typeOfKey ==
-            BOOLSOLO) { // if key is unused or associates with correct type
-      boolData[key] = std::vector<bool>({value});
-      inUse[key] = BOOLSOLO; // since this is set with SET, it is a single value
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is bool." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
+    setValue(keyID(key), value);
   }
   inline void set(const std::string &key, const double &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == DOUBLE ||
-        typeOfKey ==
-            DOUBLESOLO) { // if key is unused or associates with correct type
-      doubleData[key] = std::vector<double>({value});
-      inUse[key] =
-          DOUBLESOLO; // since this is set with SET, it is a single value
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is double." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
+    setValue(keyID(key), value);
   }
   inline void set(const std::string &key, const int &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == INT ||
-        typeOfKey ==
-            INTSOLO) { // if key is unused or associates with correct type
-      intData[key] = std::vector<int>({value});
-      inUse[key] = INTSOLO; // since this is set with SET, it is a single value
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is int." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
+    setValue(keyID(key), value);
   }
   inline void set(const std::string &key, const std::string &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == STRING ||
-        typeOfKey ==
-            STRINGSOLO) { // if key is unused or associates with correct type
-      stringData[key] = std::vector<std::string>({value});
-      inUse[key] = STRINGSOLO;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is string." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
+    setValue(keyID(key), value);
+  }
+  inline void set(const Key &key, const bool &value) { setValue(key.id, value); }
+  inline void set(const Key &key, const double &value) { setValue(key.id, value); }
+  inline void set(const Key &key, const int &value) { setValue(key.id, value); }
+  inline void set(const Key &key, const std::string &value) {
+    setValue(key.id, value);
   }
 
   // set functions (bool,double,int,string) that take a **vector** of value -
   // either make new map entry or replace existing
   // outputBehavior is set as though there was an append (i.e. list)
   inline void set(const std::string &key, const std::vector<bool> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == BOOL ||
-        typeOfKey ==
-            BOOLSOLO) { // if key is unused or associates with correct type
-      boolData[key] = value;
-      inUse[key] = BOOL;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of bool." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    setValues(keyID(key), value);
   }
   inline void set(const std::string &key, const std::vector<double> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == DOUBLE ||
-        typeOfKey ==
-            DOUBLESOLO) { // if key is unused or associates with correct type
-      doubleData[key] = value;
-      inUse[key] = DOUBLE;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of double." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    setValues(keyID(key), value);
   }
   inline void set(const std::string &key, const std::vector<int> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == INT ||
-        typeOfKey ==
-            INTSOLO) { // if key is unused or associates with correct type
-      intData[key] = value;
-      inUse[key] = INT;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of int." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    setValues(keyID(key), value);
   }
   inline void set(const std::string &key, const std::vector<std::string> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == STRING ||
-        typeOfKey ==
-            STRINGSOLO) { // if key is unused or associates with correct type
-      stringData[key] = value;
-      inUse[key] = STRING;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of string." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST);
+    setValues(keyID(key), value);
   }
 
   // append a value to the end of vector associated with key. If key is not
   // found, start a new vector for key
   inline void append(const std::string &key, const bool &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = BOOL; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == BOOL ||
-               typeOfKey == BOOLSOLO) { // if this key is in data map as a
-                                        // string, append to vector
-      boolData[key].push_back(value);
-      inUse[key] = BOOL;
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type bool to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    appendValue(keyID(key), value);
   }
   inline void append(const std::string &key, const double &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = DOUBLE; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == DOUBLE ||
-               typeOfKey == DOUBLESOLO) { // if this key is in data map as a
-                                          // string, append to vector
-      doubleData[key].push_back(value);
-      inUse[key] = DOUBLE;
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type double to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    appendValue(keyID(key), value);
   }
   inline void append(const std::string &key, const int &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = INT; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == INT ||
-               typeOfKey == INTSOLO) { // if this key is in data map as a
-                                       // string, append to vector
-      intData[key].push_back(value);
-      inUse[key] = INT; // set the in use to be a list rather then a solo
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type int to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    appendValue(keyID(key), value);
   }
   inline void append(const std::string &key, const std::string &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = STRING; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == STRING ||
-               typeOfKey == STRINGSOLO) { // if this key is in data map as a
-                                          // string, append to vector
-      stringData[key].push_back(value);
-      inUse[key] = STRING; // set the in use to be a list rather then a solo
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type string to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST);
+    appendValue(keyID(key), value);
+  }
+  inline void append(const Key &key, const bool &value) {
+    appendValue(key.id, value);
+  }
+  inline void append(const Key &key, const double &value) {
+    appendValue(key.id, value);
+  }
+  inline void append(const Key &key, const int &value) {
+    appendValue(key.id, value);
+  }
+  inline void append(const Key &key, const std::string &value) {
+    appendValue(key.id, value);
   }
 
   // append a vector of values to the end of vector associated with key. If key
   // is not found, start a new vector for key
   inline void append(const std::string &key, const std::vector<bool> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
+    int id = keyID(key);
+    dataMapType typeOfKey = typeOf(id);
     if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
+      setValues(id, value);
     } else if (typeOfKey == BOOL ||
                typeOfKey == BOOLSOLO) { // if this key is in data map as a
                                         // string, append to vector
-      boolData[key].insert(boolData[key].end(), value.begin(), value.end());
-      inUse[key] = BOOL; // may have been solo - make sure it's list
+      auto &entry = *findEntry(id);
+      auto &list = asList<bool>(entry);
+      list.insert(list.end(), value.begin(), value.end());
+      entry.type = BOOL; // may have been solo - make sure it's list
     } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type bool "
-              "to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
+      appendConflict(id, "", "bool", true);
     }
-	setOutputBehavior(key, LIST | AVE);
+    findEntry(id)->outputBehavior = LIST | AVE;
   }
   inline void append(const std::string &key, const std::vector<double> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
+    int id = keyID(key);
+    dataMapType typeOfKey = typeOf(id);
     if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
+      setValues(id, value);
     } else if (typeOfKey == DOUBLE) { // if this key is in data map as a string,
                                       // append to vector
-      doubleData[key].insert(doubleData[key].end(), value.begin(), value.end());
-      inUse[key] = DOUBLE; // may have been solo - make sure it's list
+      auto &list = asList<double>(*findEntry(id));
+      list.insert(list.end(), value.begin(), value.end());
     } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type "
-              "double to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
+      appendConflict(id, "", "double", true);
     }
-	setOutputBehavior(key, LIST | AVE);
+    findEntry(id)->outputBehavior = LIST | AVE;
   }
   inline void append(const std::string &key, const std::vector<int> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
+    int id = keyID(key);
+    dataMapType typeOfKey = typeOf(id);
     if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
+      setValues(id, value);
     } else if (typeOfKey == INT) { // if this key is in data map as a string,
                                    // append to vector
-      intData[key].insert(intData[key].end(), value.begin(), value.end());
-      inUse[key] = INT; // may have been solo - make sure it's list
+      auto &list = asList<int>(*findEntry(id));
+      list.insert(list.end(), value.begin(), value.end());
     } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type int "
-              "to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
+      appendConflict(id, "", "int", true);
     }
-	setOutputBehavior(key, LIST | AVE);
+    findEntry(id)->outputBehavior = LIST | AVE;
   }
   inline void append(const std::string &key, const std::vector<std::string> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
+    int id = keyID(key);
+    dataMapType typeOfKey = typeOf(id);
     if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
+      setValues(id, value);
     } else if (typeOfKey == STRING) { // if this key is in data map as a string,
                                       // concat new string with existing value
-		stringData[key] = { stringData[key][0] + value[0] };
-      inUse[key] = STRING; // may have been solo - make sure it's list
+      auto &list = asList<std::string>(*findEntry(id));
+      list = {list[0] + value[0]};
     } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type "
-              "string to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
+      appendConflict(id, "", "string", true);
     }
-	setOutputBehavior(key, LIST);
+    findEntry(id)->outputBehavior = LIST;
   }
 
   // merge contents of two data maps - if common keys are found behavior is determined by 'replace'
@@ -463,13 +536,19 @@ public:
   // replace 1 = keep current value - if the same key exists in both maps, keep the current value
   // replace 3 = keep the other value - if the same key exists in both maps, keep the other value
   // merge will attempt to merge outputBehavior
-  inline void merge(DataMap otherDataMap, int replace = 0) {
-	  for (std::string key : otherDataMap.getKeys()) {
-		  dataMapType typeOfKey = findKeyInData(key);
-		  dataMapType typeOfOtherKey = otherDataMap.findKeyInData(key);
+  inline void merge(const DataMap &otherDataMap, int replace = 0) {
+    merge(DataMap(otherDataMap), replace);
+  }
+  // as above, but the values are moved out of otherDataMap
+  inline void merge(DataMap &&otherDataMap, int replace = 0) {
+	  for (auto &other : otherDataMap.entries) {
+		  if (other.type == NONE || other.outputBehavior == NO_OUTPUT) {
+			  continue; // as getKeys()
+		  }
+		  dataMapType typeOfKey = typeOf(other.key);
 		  if (replace == 0) { // no replacement allowed!
 			  if (typeOfKey != NONE) { // make sure key is not in both data maps
-				  std::cout << "  In DataMap::merge() - attempt to merge key: \"" << key
+				  std::cout << "  In DataMap::merge() - attempt to merge key: \"" << keyName(other.key)
 					  << "\" but key exists in both data maps and replace = 0!\n  Exiting." << std::endl;
 			  }
 		  }
@@ -480,294 +559,101 @@ public:
 		  //  or
 		  //   rule is keep current, and this key is not already in this data map (replace = 1)
 		  if (replace == 2 || replace == 0 || (replace == 1 && typeOfKey == NONE)) {
-			  if (typeOfOtherKey == BOOL || typeOfOtherKey == BOOLSOLO) {
-				  set(key, otherDataMap.getBoolVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
+			  if (other.type == BOOL || other.type == BOOLSOLO) {
+				  setValues(other.key, takeList<bool>(other));
 			  }
-			  if (typeOfOtherKey == DOUBLE || typeOfOtherKey == DOUBLESOLO) {
-				  set(key, otherDataMap.getDoubleVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
+			  if (other.type == DOUBLE || other.type == DOUBLESOLO) {
+				  setValues(other.key, takeList<double>(other));
 			  }
-			  if (typeOfOtherKey == INT || typeOfOtherKey == INTSOLO) {
-				  set(key, otherDataMap.getIntVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
+			  if (other.type == INT || other.type == INTSOLO) {
+				  setValues(other.key, takeList<int>(other));
 			  }
-			  if (typeOfOtherKey == STRING || typeOfOtherKey == STRINGSOLO) {
-				  set(key, otherDataMap.getStringVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
+			  if (other.type == STRING || other.type == STRINGSOLO) {
+				  setValues(other.key, takeList<std::string>(other));
 			  }
+			  findEntry(other.key)->outputBehavior = other.outputBehavior;
 		  }
 	  }
   }
 
-  inline std::vector<bool> getBoolVector(
-      const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      return boolData[key];
-    } else {
-      std::cout << "  in DataMap::getBoolVector :: attempt to use getBoolVector "
-              "with key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+  // copies of the values of key
+  inline std::vector<bool> getBoolVector(const std::string &key) {
+    return copyOf<bool>(checkedEntry<bool>(keyID(key), "getBoolVector"));
   }
-  inline std::vector<double> getDoubleVector(
-      const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      return doubleData[key];
-    } else {
-      std::cout << "  in DataMap::getDoubleVector :: attempt to use getDoubleVector "
-              "with key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+  inline std::vector<double> getDoubleVector(const std::string &key) {
+    return copyOf<double>(checkedEntry<double>(keyID(key), "getDoubleVector"));
   }
-  inline std::vector<int> getIntVector(
-      const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      return intData[key];
-    } else {
-      std::cout << "  in DataMap::getIntVector :: attempt to use getIntVector with "
-              "key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+  inline std::vector<int> getIntVector(const std::string &key) {
+    return copyOf<int>(checkedEntry<int>(keyID(key), "getIntVector"));
   }
-  inline std::vector<std::string> getStringVector(
-      const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      return stringData[key];
-    } else {
-      std::cout << "  in DataMap::getStringVector :: attempt to use getStringVector "
-              "with key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+  inline std::vector<std::string> getStringVector(const std::string &key) {
+    return copyOf<std::string>(
+        checkedEntry<std::string>(keyID(key), "getStringVector"));
   }
 
-  inline std::string getStringOfVector(const std::string &key) { // retrieve a string from
-                                                       // a dataMap with "key" -
-                                                       // if not already string,
-                                                       // will be converted
-    std::string returnString = "";
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) {
-      std::cout << "  In DataMap::GetString() :: key \"" << key
-           << "\" is not in data map!\n  exiting." << std::endl;
-      exit(1);
-    } else {
-      if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-        for (auto e : boolData[key]) {
-          returnString += to_string(e) + ",";
-        }
-      } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-        for (auto e : doubleData[key]) {
-          returnString += std::to_string(e) + ",";
-        }
-      } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-        for (auto e : intData[key]) {
-          returnString += std::to_string(e) + ",";
-        }
-      } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-        for (auto e : stringData[key]) {
-          returnString += e + ",";
-        }
-      }
-    }
-    if (returnString.size() > 2) { // if vector was not empty
-      returnString.pop_back();     // remove trailing ","
-    }
-    returnString += "";
-    return returnString;
+  inline Values<double> getDoubleValues(const std::string &key) {
+    return valuesOf<double>(keyID(key), "getDoubleValues");
   }
-
-  // get ave of values in a vector - must be bool, double or, int
-  inline double
-  getAverage(std::string key) { // not ref, we may need to change to a "{LIST}" key
-    dataMapType typeOfKey = findKeyInData(key);
-    double returnValue = 0;
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      for (auto e : boolData[key]) {
-        returnValue += (double)e;
-      }
-      if (boolData[key].size() > 1) {
-        returnValue /= boolData[key].size();
-      } // else vector is  size 1, no div needed or vector is empty, returnValue
-        // will be 0
-    } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      for (auto e : doubleData[key]) {
-        returnValue += (double)e;
-      }
-      if (doubleData[key].size() > 1) {
-        returnValue /= doubleData[key].size();
-      } // else vector is  size 1, no div needed or vector is empty, returnValue
-        // will be 0
-    } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      for (auto e : intData[key]) {
-        returnValue += (double)e;
-      }
-      if (intData[key].size() > 1) {
-        returnValue /= intData[key].size();
-      } // else vector is  size 1, no div needed or vector is empty, returnValue
-        // will be 0
-    } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      std::cout << "  in DataMap::getAverage attempt to use with vector of type "
-              "string associated key \""
-           << key << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
-      exit(1);
-    } else if (typeOfKey == NONE) {
-      std::cout << "  in DataMap::getAverage attempt to get average from "
-              "nonexistent key \""
-           << key << "\".\n  Exiting." << std::endl;
-      exit(1);
-    }
-    return returnValue;
+  inline Values<double> getDoubleValues(const Key &key) {
+    return valuesOf<double>(key.id, "getDoubleValues");
+  }
+  inline Values<int> getIntValues(const std::string &key) {
+    return valuesOf<int>(keyID(key), "getIntValues");
+  }
+  inline Values<int> getIntValues(const Key &key) {
+    return valuesOf<int>(key.id, "getIntValues");
+  }
+  inline Values<std::string> getStringValues(const std::string &key) {
+    return valuesOf<std::string>(keyID(key), "getStringValues");
   }
 
-  inline double
-  getVariance(std::string key) { // not ref, we may need to change to a "{LIST}" key
-    dataMapType typeOfKey = findKeyInData(key);
-    double averageValue(0);
-    double varianceValue(0);
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      for (auto e : boolData[key]) {
-        averageValue += (double)e;
-      }
-      averageValue /= boolData[key].size();
-      for (auto e : boolData[key]) {
-        varianceValue +=
-            ((double)e - averageValue) * ((double)e - averageValue);
-      }
-      if (boolData[key].size() > 0)
-        varianceValue /= boolData[key].size() - 1;
-      else
-        varianceValue = 0;
-    } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      for (auto e : doubleData[key]) {
-        averageValue += (double)e;
-      }
-      averageValue /= doubleData[key].size();
-      for (auto e : doubleData[key]) {
-        varianceValue +=
-            ((double)e - averageValue) * ((double)e - averageValue);
-      }
-      if (doubleData[key].size() > 0)
-        varianceValue /= doubleData[key].size() - 1;
-      else
-        varianceValue = 0;
-    } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      for (auto e : intData[key]) {
-        averageValue += (double)e;
-      }
-      averageValue /= intData[key].size();
-      for (auto e : intData[key]) {
-        varianceValue +=
-            ((double)e - averageValue) * ((double)e - averageValue);
-      }
-      if (intData[key].size() > 0)
-        varianceValue /= intData[key].size() - 1;
-      else
-        varianceValue = 0;
-    } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      std::cout << "  in DataMap::getVariance attempt to use with vector of type "
-              "string associated key \""
-           << key << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
-      exit(1);
-    } else if (typeOfKey == NONE) {
-      std::cout << "  in DataMap::getVariance attempt to get value from nonexistent "
-              "key \""
-           << key << "\".\n  Exiting." << std::endl;
-      exit(1);
-    }
-    return varianceValue;
+  // the first value of key (exits if key has no values)
+  inline bool getFirstBool(const std::string &key) {
+    return firstOf<bool>(keyID(key), "getFirstBool");
+  }
+  inline bool getFirstBool(const Key &key) {
+    return firstOf<bool>(key.id, "getFirstBool");
+  }
+  inline double getFirstDouble(const std::string &key) {
+    return firstOf<double>(keyID(key), "getFirstDouble");
+  }
+  inline double getFirstDouble(const Key &key) {
+    return firstOf<double>(key.id, "getFirstDouble");
+  }
+  inline int getFirstInt(const std::string &key) {
+    return firstOf<int>(keyID(key), "getFirstInt");
+  }
+  inline int getFirstInt(const Key &key) {
+    return firstOf<int>(key.id, "getFirstInt");
+  }
+  inline std::string getFirstString(const std::string &key) {
+    return firstOf<std::string>(keyID(key), "getFirstString");
   }
 
+  // retrieve a string from a dataMap with "key" - if not already string, will
+  // be converted
+  std::string getStringOfVector(const std::string &key);
+
   // get ave of values in a vector - must be bool, double or, int
-  inline double
-  getSum(std::string key) { // not ref, we may need to change to a "{LIST}" key
-    dataMapType typeOfKey = findKeyInData(key);
-    double returnValue = 0;
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      for (auto e : boolData[key]) {
-        returnValue += (double)e;
-      }
-      // if (boolData[key].size() > 1) {
-      //	returnValue /= boolData[key].size();
-      //} // else vector is  size 1, no div needed or vector is empty,
-      //returnValue will be 0
-    } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      for (auto e : doubleData[key]) {
-        returnValue += (double)e;
-      }
-      // if (doubleData[key].size() > 1) {
-      //	returnValue /= doubleData[key].size();
-      //} // else vector is  size 1, no div needed or vector is empty,
-      //returnValue will be 0
-    } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      for (auto e : intData[key]) {
-        returnValue += (double)e;
-      }
-      // if (intData[key].size() > 1) {
-      //	returnValue /= intData[key].size();
-      //} // else vector is  size 1, no div needed or vector is empty,
-      //returnValue will be 0
-    } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      std::cout << "  in DataMap::getAverage attempt to use with vector of type "
-              "string associated key \""
-           << key << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
-      exit(1);
-    } else if (typeOfKey == NONE) {
-      std::cout << "  in DataMap::getAverage attempt to get average from "
-              "nonexistent key \""
-           << key << "\".\n  Exiting." << std::endl;
-      exit(1);
-    }
-    return returnValue;
-  }
+  double getAverage(const std::string &key);
+  double getAverage(const Key &key);
+  double getVariance(const std::string &key);
+  // get sum of values in a vector - must be bool, double or, int
+  double getSum(const std::string &key);
+  double getSum(const Key &key);
+  double getMin(const std::string &key);
+  double getMax(const std::string &key);
 
   // Clear a field in a DataMap
   inline void clear(const std::string &key) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey != NONE) {
-      if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) { // data is bool
-        boolData.erase(key);
-      } else if (typeOfKey == DOUBLE ||
-                 typeOfKey == DOUBLESOLO) { // data is double
-        doubleData.erase(key);
-      } else if (typeOfKey == INT || typeOfKey == INTSOLO) { // data is int
-        intData.erase(key);
-      } else if (typeOfKey == STRING ||
-                 typeOfKey == STRINGSOLO) { // data is string
-        stringData.erase(key);
-      }
-      inUse.erase(key);
+    if (auto entry = findEntry(keyID(key))) {
+      entry->type = NONE; // the output behavior is kept
+      entry->value = false;
     }
   }
 
   // Clear all data in a DataMap
-  inline void clearMap() {
-    boolData.clear();
-    doubleData.clear();
-    intData.clear();
-    stringData.clear();
-    inUse.clear();
-  }
+  inline void clearMap() { entries.clear(); }
 
   inline bool
   fieldExists(const std::string &key) { // return true if a data map contains "key"
@@ -780,73 +666,53 @@ public:
                                      const std::vector<std::string> &keys,
                                      bool aveOnly = false);
 
+  // add the same columns constructHeaderAndDataStrings would write, as typed
+  // values, to the current row of table
+  void appendToTable(ColumnarTable &table, const std::vector<std::string> &keys,
+                     bool aveOnly = false);
+
+  // the entry for key and the output behavior it is written to a file with
+  // (exits if key is not in this data map, or can not be written with its
+  // output behavior)
+  Entry &fileOutputBehavior(const std::string &key, unsigned int &OB,
+                            bool aveOnly);
+
   inline void writeToFile(const std::string &fileName,
                           const std::vector<std::string> &keys = {},
                           bool aveOnly = false) {
     // Set("score{LIST}",10.0);
 
-    if (FileManager::files.find(fileName) ==
-        FileManager::files
-            .end()) { // first make sure that the dataFile has been set up.
+    std::unique_lock<std::recursive_mutex> lock(FileManager::fileMutex);
+    auto &file = FileManager::getFile(fileName);
+    if (!file.created && file.columns.empty()) { // first make sure that the
+                                                 // dataFile has been set up.
       if (keys.size() == 0) { // if no keys are given
-        FileManager::fileColumns[fileName] = getKeys();
+        file.columns = getKeys();
       } else {
-        FileManager::fileColumns[fileName] = keys;
+        file.columns = keys;
       }
     }
+    // columns are only set when a file is created, so this stays valid
+    const auto &columns = file.columns;
+    if (file.table) { // a columnar file (see ARCHIVIST_DEFAULT-format)
+      FileManager::openFile(file);
+      appendToTable(*file.table, columns, aveOnly);
+      FileManager::endTableRow(file);
+      return;
+    }
+    lock.unlock();
+
     std::string headerStr = "";
     std::string dataStr = "";
 
-    constructHeaderAndDataStrings(headerStr, dataStr,
-                                  FileManager::fileColumns[fileName],
+    constructHeaderAndDataStrings(headerStr, dataStr, columns,
                                   aveOnly); // if a list is given, use that.
 
-    FileManager::writeToFile(fileName, dataStr,
+    FileManager::writeToFile(file, dataStr,
                              headerStr); // write the data to file!
   }
 
-  inline std::vector<std::string> getColumnNames() {
-    std::vector<std::string> columnNames;
-
-    for (auto element : inUse) {
-      //if (outputBehavior.find(element.first) == outputBehavior.end()) {
-      //  // this element has no defined output behavior, so it will be LIST
-      //  // (default) or FIRST (if it's a solo value)
-      //  if (element.second == BOOLSOLO || element.second == DOUBLESOLO ||
-      //      element.second == INTSOLO || element.second == STRINGSOLO) {
-      //    columnNames.push_back(element.first);
-      //  } else {
-      //    columnNames.push_back(element.first + "_LIST");
-      //  }
-      //} else { // there is an output behavior defined
-		 {
-        auto OB = outputBehavior[element.first];
-        if (OB & AVE) {
-          columnNames.push_back(element.first + "_AVE");
-        }
-        if (OB & FIRST) {
-          columnNames.push_back(element.first);
-        }
-        if (OB & SUM) {
-          std::cout << "  WARNING OUTPUT METHOD SUM IS HAS YET TO BE WRITTEN!"
-               << std::endl;
-        }
-        if (OB & PROD) {
-          std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
-               << std::endl;
-        }
-        if (OB & STDERR) {
-          std::cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!"
-               << std::endl;
-        }
-        if (OB & LIST) {
-          columnNames.push_back(element.first + "_LIST");
-        }
-		  // if (OB & NO_OUTPUT) do nothing...
-      }
-    }
-    return columnNames;
-  }
+  std::vector<std::string> getColumnNames();
   //	/*
   //	 * takes a vector of string with key value pairs. Calls set for each
   //pair.
@@ -871,7 +737,8 @@ public:
         if (entryType == DOUBLE || entryType == DOUBLESOLO) {
           copyDataMap.set(prefix + "_" + key, getDoubleVector(key));
         }
-        copyDataMap.setOutputBehavior(prefix + "_" + key, outputBehavior[key]);
+        copyDataMap.setOutputBehavior(prefix + "_" + key,
+                                      findEntry(keyID(key))->outputBehavior);
       }
     } else {
       for (auto key : getKeys()) {
@@ -3,6 +3,7 @@
 #include "Filesystem.h"
 #include <vector>
 #include <regex>
+#include <cstring>
 #include <string>
 
 // given a path or filename, return T or F if it exists already
@@ -30,6 +31,22 @@ bool isDirectory(const std::string& dirname) {
 #endif
 }
 
+// given a path or filename, cut the file down to its first size bytes.
+// return F if the file could not be changed
+bool truncateFile(const std::string& filename, long long size) {
+#if defined(OS_UNIX)
+    return (truncate(filename.c_str(), size) == 0);
+#elif defined(OS_WINDOWS)
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER position;
+    position.QuadPart = size;
+    bool done = SetFilePointerEx(file, position, NULL, FILE_BEGIN) && SetEndOfFile(file);
+    CloseHandle(file);
+    return done;
+#endif
+}
+
 // given a dir path, and a bash-style wildcard pattern, get all files that match the pattern, saving into given vector of strings (RECURSIVE)
 // curPath: string.  Ex: "./"
 // depthIntoFilterPathParts: uint.  Ex: 3  (this is which subpattern of the vector `filterPathParts` we're currently matching for)
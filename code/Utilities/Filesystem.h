@@ -19,6 +19,7 @@
   #include <sys/types.h> // linux only
   #include <dirent.h> // linux only
   #include <sys/stat.h> // linux only (stat, lstat)
+  #include <unistd.h> // linux only (truncate)
 #elif defined(OS_WINDOWS)
   #include <windows.h>
 #endif
@@ -35,6 +36,10 @@ bool fileExists(const std::string & /*filename*/);
 // given a path or filename, return T if directory, F if file
 bool isDirectory(const std::string & /*dirname*/);
 
+// given a path or filename, cut the file down to its first size bytes.
+// return F if the file could not be changed
+bool truncateFile(const std::string & /*filename*/, long long /*size*/);
+
 // given a dir path, and a bash-style wildcard pattern, get all files that match the pattern, saving into given vector of strings (RECURSIVE)
 // curPath: string.  Ex: "./"
 // depthIntoFilterPathParts: uint.  Ex: 3  (this is which subpattern of the vector `filterPathParts` we're currently matching for)
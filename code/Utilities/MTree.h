@@ -632,10 +632,11 @@ public:
 class fromDataMapAve_MTree : public Abstract_MTree {
 public:
 	std::string key;
+	DataMap::Key dataMapKey; // key, looked up once
 
-	fromDataMapAve_MTree() {
+	fromDataMapAve_MTree() : dataMapKey("") {
 	}
-	fromDataMapAve_MTree(std::string _key) : key(_key) {}
+	fromDataMapAve_MTree(std::string _key) : key(_key), dataMapKey(_key) {}
 	virtual ~fromDataMapAve_MTree() = default;
 	virtual std::shared_ptr<Abstract_MTree>
 		makeCopy(std::vector<std::shared_ptr<Abstract_MTree>> _branches = {}) override {
@@ -647,7 +648,7 @@ public:
 		eval(DataMap &dataMap, std::shared_ptr<ParametersTable> PT,
 			const std::vector<std::vector<double>> &vectorData) override {
 		std::vector<double> output;
-		output.push_back(dataMap.getAverage(key));
+		output.push_back(dataMap.getAverage(dataMapKey));
 		return output;
 	}
 	virtual void show(int indent = 0) override {
@@ -662,10 +663,11 @@ public:
 class fromDataMapSum_MTree : public Abstract_MTree {
 public:
 	std::string key;
+	DataMap::Key dataMapKey; // key, looked up once
 
-	fromDataMapSum_MTree() {
+	fromDataMapSum_MTree() : dataMapKey("") {
 	}
-	fromDataMapSum_MTree(std::string _key) : key(_key) {}
+	fromDataMapSum_MTree(std::string _key) : key(_key), dataMapKey(_key) {}
 	virtual ~fromDataMapSum_MTree() = default;
 	virtual std::shared_ptr<Abstract_MTree>
 		makeCopy(std::vector<std::shared_ptr<Abstract_MTree>> _branches = {}) override {
@@ -677,7 +679,7 @@ public:
 		eval(DataMap &dataMap, std::shared_ptr<ParametersTable> PT,
 			const std::vector<std::vector<double>> &vectorData) override {
 		std::vector<double> output;
-		output.push_back(dataMap.getSum(key));
+		output.push_back(dataMap.getSum(dataMapKey));
 		return output;
 	}
 	virtual void show(int indent = 0) override {
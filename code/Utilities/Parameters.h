@@ -24,6 +24,8 @@
 #include <stdexcept>
 #include <unordered_map>
 #include <set>
+#include <mutex>
+#include <shared_mutex>
 #include <memory>
 #include <vector>
 
@@ -1277,6 +1279,7 @@ public:
   std::shared_ptr<ParametersTable> table;    // the table that owns this entry
   std::map<long long, std::shared_ptr<ParametersEntry<T>>>
       entriesCache; // used to track entries in other name spaces
+  std::shared_mutex cacheMutex; // get() may be called from many threads
 
   ParameterLink(std::string _name, std::shared_ptr<ParametersEntry<T>> _entry,
                 std::shared_ptr<ParametersTable> _table)
@@ -1296,17 +1299,21 @@ public:
                 << std::endl;
       exit(1);
     }
-    auto mapRecord = entriesCache.find(lookupTable->getID());
-    if (mapRecord ==
-        entriesCache.end()) { // if the cache does not contain this table
-      T lookupValue;
-      lookupTable->lookup(name, lookupValue);
-      entriesCache[lookupTable->getID()] =
-          std::dynamic_pointer_cast<ParametersEntry<T>>(
-              lookupTable->getEntry(name));
-      return lookupValue;
+    {
+      std::shared_lock<std::shared_mutex> readLock(cacheMutex);
+      auto mapRecord = entriesCache.find(lookupTable->getID());
+      if (mapRecord != entriesCache.end()) {
+        return mapRecord->second->get();
+      }
     }
-    return entriesCache[lookupTable->getID()]->get();
+    // the cache does not contain this table
+    std::unique_lock<std::shared_mutex> writeLock(cacheMutex);
+    T lookupValue;
+    lookupTable->lookup(name, lookupValue);
+    entriesCache[lookupTable->getID()] =
+        std::dynamic_pointer_cast<ParametersEntry<T>>(
+            lookupTable->getEntry(name));
+    return lookupValue;
   }
 
   // T lookup() {
@@ -1319,20 +1326,26 @@ public:
 
   void set(T value) {
     table->setParameter(name, value);
+    std::unique_lock<std::shared_mutex> writeLock(cacheMutex);
     entriesCache[table->getID()] =
         std::dynamic_pointer_cast<ParametersEntry<T>>(table->getEntry(name));
   }
 
   void set(T value, std::shared_ptr<ParametersTable> lookupTable) {
     lookupTable->setParameter(name, value);
+    std::unique_lock<std::shared_mutex> writeLock(cacheMutex);
     entriesCache[lookupTable->getID()] =
         std::dynamic_pointer_cast<ParametersEntry<T>>(
             lookupTable->getEntry(name));
   }
 
-  void clearCache() { entriesCache.clear(); }
+  void clearCache() {
+    std::unique_lock<std::shared_mutex> writeLock(cacheMutex);
+    entriesCache.clear();
+  }
 
   void clearCache(std::shared_ptr<ParametersTable> _table) {
+    std::unique_lock<std::shared_mutex> writeLock(cacheMutex);
     auto mapRecord = entriesCache.find(_table->getID());
     if (mapRecord !=
         entriesCache
@@ -1355,6 +1368,7 @@ public:
   static std::shared_ptr<ParametersTable> root;
   static bool save_files;
   static std::string save_file_prefix;
+  static std::string restart_file; // checkpoint to restart from (-r)
 
   template <typename T>
   static std::shared_ptr<ParameterLink<T>>
@@ -10,13 +10,16 @@
 
 // This file provides a wrapper around C++11's style of generating random
 // numbers. We provide a "common" number generator so the entire code
-// base can work with a global seed if they want, as well as some
-// utility functions for getting common number types easily.
+// base can work with a global seed if they want, streams (generators derived
+// from the global seed and a key, for work that may run on any thread), as
+// well as some utility functions for getting common number types easily.
 
 #pragma once
 
 #include <random>
 #include <climits> // UINT_MAX
+#include <cstdint>
+#include <initializer_list>
 
 namespace Random {
 
@@ -26,9 +29,20 @@ using Generator = std::mt19937;
 static const int32_t _BINOMIAL_TO_NORMAL = 50;     // if < n*p*(1-p)
 static const int32_t _BINOMIAL_TO_POISSON = 1000;  // if < n && !Normal approx Engine
 
+// The generator (if any) installed on the calling thread by a GeneratorScope.
+// Tasks run on a ThreadPool install their own generator so that they never
+// share (or race on) the common generator.
+inline Generator *&getThreadGenerator() {
+  static thread_local Generator *threadGenerator = nullptr;
+  return threadGenerator;
+}
+
 // Gives you access to the random number generator in general use
 inline Generator &getCommonGenerator() {
   // to seed, do get_common_generator().seed(value);
+  if (getThreadGenerator() != nullptr) {
+    return *getThreadGenerator();
+  }
   static Generator
       common; // This creates "common" which is a (random number) generator.
   // Since it is static, it is only created the first time this function is
@@ -38,6 +52,69 @@ inline Generator &getCommonGenerator() {
   return common;
 }
 
+// While a GeneratorScope is alive, getCommonGenerator() (and so every
+// function below using the default generator) on this thread uses "gen".
+// Scopes may be nested, the previous generator is restored on destruction.
+class GeneratorScope {
+  Generator *previous;
+
+public:
+  explicit GeneratorScope(Generator &gen) : previous(getThreadGenerator()) {
+    getThreadGenerator() = &gen;
+  }
+  ~GeneratorScope() { getThreadGenerator() = previous; }
+
+  GeneratorScope(const GeneratorScope &) = delete;
+  GeneratorScope &operator=(const GeneratorScope &) = delete;
+};
+
+// Streams
+// A stream is a generator whose seed is derived from the run seed (set from
+// GLOBAL-randomSeed) and a list of keys, i.e.
+//   auto gen = Random::makeStream({Random::REPRODUCTION_STREAM, org->ID});
+// The same run seed and keys always give the same sequence, no matter which
+// thread the stream is used on or what else has drawn random numbers. Use a
+// GeneratorScope to have code that uses the default generator draw from it.
+enum StreamType : uint64_t {
+  EVALUATION_STREAM = 1,   // evaluating an organism in a world
+  REPRODUCTION_STREAM = 2, // genome mutation and brain construction of a birth
+};
+
+inline uint64_t &getRunSeed() {
+  static uint64_t runSeed = 0;
+  return runSeed;
+}
+
+// to seed, do Random::setRunSeed(value); (main does this from
+// GLOBAL-randomSeed)
+inline void setRunSeed(uint64_t seed) { getRunSeed() = seed; }
+
+// splitmix64 finalizer, spreads a 64 bit value over all 64 bits
+inline uint64_t mixBits(uint64_t value) {
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+// returns a generator seeded from the run seed and keys
+inline Generator makeStream(std::initializer_list<uint64_t> keys) {
+  uint64_t hash = mixBits(getRunSeed());
+  for (auto key : keys) {
+    hash = mixBits(hash ^ key);
+  }
+  std::seed_seq seeds{static_cast<uint32_t>(hash),
+                      static_cast<uint32_t>(hash >> 32)};
+  return Generator(seeds);
+}
+
+// returns a new generator seeded by drawing from gen. use this to hand out
+// independent streams (i.e. one per task) from a single generator.
+inline Generator splitStream(Generator &gen = getCommonGenerator()) {
+  std::seed_seq seeds{gen(), gen()};
+  return Generator(seeds);
+}
+
 // result = Random::getDouble(7.2, 9.5);
 // result is in [7.2, 9.5)
 inline double getDouble(const double lower, const double upper,
@@ -158,11 +235,29 @@ inline uint32_t EmpGetRandBinomial(const int n, const double p, Generator &gen =
 }
 
 // Returns how many successes you get by doing "tests" number of trials
-// with "probability" of success
+// with "probability" of success. O(1) expected time, however many tests.
 inline int getBinomial(const int tests, const double probability,
                        Generator &gen = getCommonGenerator()) {
-  return EmpGetRandBinomial(tests, probability, gen);
-  //return std::binomial_distribution<>(tests, probability)(gen);
+  return std::binomial_distribution<>(tests, probability)(gen);
+}
+
+// Calls visit(i), in increasing order, for each trial i in [0, tests) that
+// succeeds with "probability". Jumps from one success to the next with a
+// geometric draw, so the cost follows the number of successes, not tests.
+// (i.e. which sites of a genome are hit given a per site mutation rate)
+template <class Visit>
+inline void forEachSuccess(const int tests, const double probability,
+                           Visit visit, Generator &gen = getCommonGenerator()) {
+  if (probability <= 0.0)
+    return;
+  if (probability >= 1.0) {
+    for (int i = 0; i < tests; i++)
+      visit(i);
+    return;
+  }
+  std::geometric_distribution<long long> gap(probability);
+  for (long long i = gap(gen); i < tests; i += 1 + gap(gen))
+    visit((int)i);
 }
 
 // Returns a double drawn from a normal (Gaussian) distribution with mean "mu"
@@ -0,0 +1,166 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+// true while this thread is running a task (used to run nested jobs serially)
+thread_local bool insideTask = false;
+}
+
+ThreadPool::ThreadPool(int nrThreads) { resize(nrThreads); }
+
+ThreadPool::~ThreadPool() { stopWorkers(); }
+
+void ThreadPool::resize(int nrThreads) {
+  std::lock_guard<std::mutex> callLock(callMutex);
+  stopWorkers();
+  stopping = false;
+  for (int i = 1; i < std::max(1, nrThreads); i++) {
+    workers.emplace_back([this] { workerLoop(); });
+  }
+}
+
+void ThreadPool::stopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    stopping = true;
+  }
+  jobReady.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  workers.clear();
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)> &task) {
+  if (workers.empty() || count < 2 || insideTask) {
+    for (int i = 0; i < count; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> callLock(callMutex);
+  {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    job = &task;
+    jobCount = count;
+    jobError = nullptr;
+    nextIndex = 0;
+    busyWorkers = static_cast<int>(workers.size());
+    jobGeneration++;
+  }
+  jobReady.notify_all();
+
+  runTasks(); // the calling thread helps out
+
+  std::unique_lock<std::mutex> lock(jobMutex);
+  jobDone.wait(lock, [this] { return busyWorkers == 0; });
+  job = nullptr;
+  if (jobError) {
+    std::rethrow_exception(jobError);
+  }
+}
+
+void ThreadPool::runTasks() {
+  insideTask = true;
+  for (int i = nextIndex++; i < jobCount; i = nextIndex++) {
+    try {
+      (*job)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(jobMutex);
+      if (!jobError) {
+        jobError = std::current_exception();
+      }
+    }
+  }
+  insideTask = false;
+}
+
+void ThreadPool::workerLoop() {
+  std::unique_lock<std::mutex> lock(jobMutex);
+  int seenGeneration = jobGeneration;
+  while (true) {
+    jobReady.wait(lock, [&] {
+      return stopping || jobGeneration != seenGeneration;
+    });
+    if (stopping) {
+      return;
+    }
+    seenGeneration = jobGeneration;
+    lock.unlock();
+    runTasks();
+    lock.lock();
+    if (--busyWorkers == 0) {
+      jobDone.notify_one();
+    }
+  }
+}
+
+ThreadPool &getCommonPool() {
+  // to size, do getCommonPool().resize(value);
+  static ThreadPool common;
+  return common;
+}
+
+TaskQueue::~TaskQueue() {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stopping = true;
+  }
+  taskReady.notify_all();
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+void TaskQueue::push(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    tasks.push_back(std::move(task));
+    if (!worker.joinable()) {
+      worker = std::thread([this] { workerLoop(); });
+    }
+  }
+  taskReady.notify_one();
+}
+
+void TaskQueue::wait() {
+  std::unique_lock<std::mutex> lock(queueMutex);
+  queueEmpty.wait(lock, [this] { return tasks.empty() && !running; });
+}
+
+void TaskQueue::workerLoop() {
+  std::unique_lock<std::mutex> lock(queueMutex);
+  while (true) {
+    taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+    if (tasks.empty()) { // stopping, and all tasks are done
+      return;
+    }
+    auto task = std::move(tasks.front());
+    tasks.pop_front();
+    running = true;
+    lock.unlock();
+    task();
+    lock.lock();
+    running = false;
+    if (tasks.empty()) {
+      queueEmpty.notify_all();
+    }
+  }
+}
+
+TaskQueue &getArchiveQueue() {
+  static TaskQueue archiveQueue;
+  return archiveQueue;
+}
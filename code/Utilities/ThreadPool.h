@@ -0,0 +1,107 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// A small fixed size pool of worker threads. Work is handed to the pool with
+// parallelFor(count, task) which calls task(i) for every i in [0, count) and
+// returns once all calls have finished. The calling thread also works on the
+// job, so a pool of size 1 has no worker threads and simply runs the job.
+//
+// Like Random::getCommonGenerator(), a "common" pool is provided so the entire
+// code base can share a single set of threads (sized with GLOBAL-threads).
+//
+// TaskQueue is a single background thread that runs tasks one at a time in the
+// order they were added. It is used to move work (i.e. writing archive files)
+// off of the main loop while keeping that work in order.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+  explicit ThreadPool(int nrThreads = 1);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // set the total number of threads (including the calling thread) used to
+  // run jobs. must not be called while a job is running.
+  void resize(int nrThreads);
+  int size() const { return static_cast<int>(workers.size()) + 1; }
+
+  // call task(i) for each i in [0, count). The order in which tasks are run
+  // is not defined. If parallelFor is called from inside a task, the inner
+  // job is run serially on the calling thread. If any task throws, the first
+  // exception is rethrown once the whole job has finished.
+  void parallelFor(int count, const std::function<void(int)> &task);
+
+private:
+  std::vector<std::thread> workers;
+
+  std::mutex callMutex; // only one job may run at a time
+  std::mutex jobMutex;  // guards the job state below
+  std::condition_variable jobReady;
+  std::condition_variable jobDone;
+
+  const std::function<void(int)> *job = nullptr;
+  int jobCount = 0;
+  int jobGeneration = 0; // incremented each time a new job is posted
+  int busyWorkers = 0;
+  bool stopping = false;
+  std::exception_ptr jobError;
+  std::atomic<int> nextIndex{0};
+
+  void workerLoop();
+  void runTasks();
+  void stopWorkers();
+};
+
+// Gives you access to the thread pool in general use
+ThreadPool &getCommonPool();
+
+class TaskQueue {
+public:
+  TaskQueue() = default;
+  ~TaskQueue();
+
+  TaskQueue(const TaskQueue &) = delete;
+  TaskQueue &operator=(const TaskQueue &) = delete;
+
+  // add task to the end of the queue. The thread is started on the first push.
+  // tasks must not throw (an exception ends the program).
+  void push(std::function<void()> task);
+  // block until every task pushed so far has finished
+  void wait();
+
+private:
+  std::thread worker;
+
+  std::mutex queueMutex; // guards the queue state below
+  std::condition_variable taskReady;
+  std::condition_variable queueEmpty;
+
+  std::deque<std::function<void()>> tasks;
+  bool running = false; // true while the worker is running a task
+  bool stopping = false;
+
+  void workerLoop();
+};
+
+// Gives you access to the queue used to write archive files in the background
+// (see GLOBAL-pipelineArchive)
+TaskQueue &getArchiveQueue();
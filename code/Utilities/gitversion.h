@@ -0,0 +1 @@
+const char *gitversion = "7e5b832f26edcec35877d321a446625e3fac0589";
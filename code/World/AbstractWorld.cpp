@@ -10,6 +10,10 @@
 
 #include "AbstractWorld.h"
 
+#include <Global.h>
+#include <Utilities/Random.h>
+#include <Utilities/ThreadPool.h>
+
 /*
 #include <math.h>
 
@@ -27,3 +31,25 @@ std::shared_ptr<ParameterLink<std::string>> AbstractWorld::worldTypePL =
         "WORLD-worldType", std::string("This_string_is_set_by_modules.h"),
         "This_string_is_set_by_modules.h");
 ////// WORLD-worldType is actually set by Modules.h //////
+
+void AbstractWorld::evaluateParallel(
+    const std::vector<std::shared_ptr<Organism>> &population,
+    const std::function<void(const std::shared_ptr<Organism> &)> &evaluateOrg,
+    bool inOrder) {
+  auto evaluateIndex = [&](int i) {
+    auto generator = Random::makeStream(
+        {Random::EVALUATION_STREAM, static_cast<uint64_t>(population[i]->ID),
+         static_cast<uint64_t>(Global::update)});
+    Random::GeneratorScope useGenerator(generator);
+    evaluateOrg(population[i]);
+  };
+
+  if (inOrder) {
+    for (int i = 0; i < static_cast<int>(population.size()); i++) {
+      evaluateIndex(i);
+    }
+  } else {
+    getCommonPool().parallelFor(static_cast<int>(population.size()),
+                                evaluateIndex);
+  }
+}
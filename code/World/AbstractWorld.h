@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <functional>
 #include <thread>
 #include <vector>
 
@@ -43,4 +44,16 @@ public:
 
   virtual void evaluate(std::map<std::string, std::shared_ptr<Group>> &groups,
 	  int analyze = 0, int visualize = 0, int debug = 0) = 0;
+
+  // calls evaluateOrg on each organism in population, spreading the work over
+  // GLOBAL-threads threads. Each organism is evaluated with it's own random
+  // number stream (derived from the run seed, the organisms ID and the
+  // update) so results are the same for any number of threads and any
+  // population order. evaluateOrg must only change the organism it is given
+  // (and not the world). If inOrder is set (i.e. for visualize or debug
+  // output) organisms are evaluated one at a time in population order.
+  void evaluateParallel(
+      const std::vector<std::shared_ptr<Organism>> &population,
+      const std::function<void(const std::shared_ptr<Organism> &)> &evaluateOrg,
+      bool inOrder = false);
 };
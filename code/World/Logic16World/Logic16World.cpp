@@ -155,10 +155,9 @@ void Logic16World::evaluate(std::map<std::string, std::shared_ptr<Group>> &group
 		} // else do nothing, we already checked for bad shuffle type in constructor
 	}
 
-	int popSize = groups[groupName]->population.size();
-	for (int i = 0; i < popSize; i++) {
-		evaluateSolo(groups[groupName]->population[i], analyze, visualize, debug);
-	}
+	evaluateParallel(groups[groupName]->population,
+		[&](const std::shared_ptr<Organism>& org) { evaluateSolo(org, analyze, visualize, debug); },
+		visualize || debug);
 }
 
 
@@ -169,28 +168,44 @@ void Logic16World::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int
 	std::vector<double> logicScores;
 	logicScores.resize(16);
 
-	for (int repeats = evaluationsPerGeneration; repeats > 0; --repeats) {
-		brain->resetBrain();
-		for (int InputIndex = 0; InputIndex < 4; InputIndex++) {
-
-			if (resetBrainBetweenInputs) {
-				brain->resetBrain();
+	if (resetBrainBetweenInputs) {
+		// every input is tested on a fresh brain, so all of them can be run as one batch
+		std::vector<std::vector<double>> inputs;
+		for (int repeats = evaluationsPerGeneration; repeats > 0; --repeats) {
+			for (int InputIndex = 0; InputIndex < 4; InputIndex++) {
+				inputs.push_back({ (double)questions[InputIndex][0], (double)questions[InputIndex][1] });
 			}
+		}
+		std::vector<std::vector<double>> outputs;
+		brain->updateBatch(inputs, outputs, brainUpdates);
+		for (size_t lane = 0; lane < inputs.size(); lane++) {
+			bool in0 = inputs[lane][0];
+			bool in1 = inputs[lane][1];
+			int outputCount = 0;
+			for (auto logic : testLogic) {
+				logicScores[logic] += (double)(logic_tables[logic][in0][in1] == Bit(outputs[lane][outputCount++]));
+			}
+		}
+	}
+	else {
+		for (int repeats = evaluationsPerGeneration; repeats > 0; --repeats) {
+			brain->resetBrain();
+			for (int InputIndex = 0; InputIndex < 4; InputIndex++) {
+				bool in0 = questions[InputIndex][0];
+				bool in1 = questions[InputIndex][1];
 
-			bool in0 = questions[InputIndex][0];
-			bool in1 = questions[InputIndex][1];
-
-			brain->setInput(0, in0);
-			brain->setInput(1, in1);
+				brain->setInput(0, in0);
+				brain->setInput(1, in1);
 
-			for (int i = 0; i < brainUpdates; i++) { // call update on brain one or more times
-				brain->update();
-			}
+				for (int i = 0; i < brainUpdates; i++) { // call update on brain one or more times
+					brain->update();
+				}
 
-			int outputCount = 0;
-			for (auto logic : testLogic) {
-				// for each logic being tested, see if the brain generated the correct output for the current input
-				logicScores[logic] += (double)(logic_tables[logic][in0][in1] == Bit(brain->readOutput(outputCount++)));
+				int outputCount = 0;
+				for (auto logic : testLogic) {
+					// for each logic being tested, see if the brain generated the correct output for the current input
+					logicScores[logic] += (double)(logic_tables[logic][in0][in1] == Bit(brain->readOutput(outputCount++)));
+				}
 			}
 		}
 	}
@@ -50,16 +50,19 @@ TestWorld::TestWorld(std::shared_ptr<ParametersTable> PT_)
 void TestWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze,
                              int visualize, int debug) {
   auto brain = org->brains[brainNamePL->get(PT)];
-  for (int r = 0; r < evaluationsPerGenerationPL->get(PT); r++) {
-    brain->resetBrain();
-    brain->setInput(0, 1); // give the brain a constant 1 (for wire brain)
-    brain->update();
+  // every evaluation sees the same input, so run them as one batch. give the
+  // brain a constant 1 (for wire brain)
+  std::vector<std::vector<double>> inputs(evaluationsPerGenerationPL->get(PT),
+                                          std::vector<double>{1});
+  std::vector<std::vector<double>> outputs;
+  brain->updateBatch(inputs, outputs, 1);
+  for (auto const &output : outputs) {
     double score = 0.0;
     for (int i = 0; i < brain->nrOutputValues; i++) {
       if (modePL->get(PT) == 0)
-        score += Bit(brain->readOutput(i));
+        score += Bit(output[i]);
       else
-        score += brain->readOutput(i);
+        score += output[i];
     }
     if (score < 0.0)
       score = 0.0;
@@ -72,11 +75,11 @@ void TestWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze,
 
 void TestWorld::evaluate(std::map<std::string, std::shared_ptr<Group>> &groups,
                       int analyze, int visualize, int debug) {
-  int popSize = groups[groupNamePL->get(PT)]->population.size();
-  for (int i = 0; i < popSize; i++) {
-    evaluateSolo(groups[groupNamePL->get(PT)]->population[i], analyze,
-                 visualize, debug);
-  }
+  evaluateParallel(groups[groupNamePL->get(PT)]->population,
+                   [&](const std::shared_ptr<Organism> &org) {
+                     evaluateSolo(org, analyze, visualize, debug);
+                   },
+                   visualize || debug);
 }
 
 std::unordered_map<std::string, std::unordered_set<std::string>>
@@ -19,9 +19,11 @@
 #include <Utilities/MTree.h>
 #include <Utilities/Parameters.h>
 #include <Utilities/Random.h>
+#include <Utilities/ThreadPool.h>
 #include <Utilities/Utilities.h>
 #include <Utilities/gitversion.h>
 #include <Utilities/Filesystem.h>
+#include <Utilities/Checkpoint.h>
 
 #include <algorithm>
 #include <csignal> // sigint
@@ -29,6 +31,7 @@
 #include <cstdlib>
 #include <memory>
 #include <regex>
+#include <sstream>
 #include <vector>
 
 
@@ -50,6 +53,11 @@ std::map<std::string, std::shared_ptr<Group>>
 constructAllGroupsFrom(const std::shared_ptr<AbstractWorld> &world,
                        std::shared_ptr<ParametersTable> PT);
 
+void saveRunCheckpoint(
+    const std::map<std::string, std::shared_ptr<Group>> &groups);
+void loadRunCheckpoint(const std::string &fileName,
+                       std::map<std::string, std::shared_ptr<Group>> &groups);
+
 int main(int argc, const char *argv[]) {
   signal(SIGINT, catchCtrlC);
 
@@ -133,12 +141,27 @@ int main(int argc, const char *argv[]) {
     int temp = rd();
 #endif
     Random::getCommonGenerator().seed(temp);
+    Random::setRunSeed(temp);
     std::cout << "Generating Random Seed\n  " << temp << "\n";
   } else {
     Random::getCommonGenerator().seed(Global::randomSeedPL->get());
+    Random::setRunSeed(Global::randomSeedPL->get());
     std::cout << "Using Random Seed: " << Global::randomSeedPL->get() << "\n";
   }
 
+  // set up worker threads (used by worlds that evaluate in parallel)
+  if (Global::threadsPL->get() < 1) {
+    std::cout << "error: GLOBAL-threads must be at least 1" << std::endl;
+    exit(1);
+  }
+  getCommonPool().resize(Global::threadsPL->get());
+  if (Global::threadsPL->get() > 1) {
+    std::cout << "Using " << Global::threadsPL->get() << " threads\n";
+  }
+  if (Global::pipelineArchivePL->get()) {
+    std::cout << "Writing archive files on a background thread\n";
+  }
+
   // make world uses WORLD-worldType to determine type of world
   auto world = makeWorld(Parameters::root);
 
@@ -149,6 +172,9 @@ int main(int argc, const char *argv[]) {
 
   Global::update = 0;
 
+  if (!Parameters::restart_file.empty()) {
+    loadRunCheckpoint(Parameters::restart_file, groups);
+  }
 
   if (Global::modePL->get() == "run") {
     ////////////////////////////////////////////////////////////////////////////////////
@@ -169,6 +195,9 @@ int main(int argc, const char *argv[]) {
       done = true; // until we find out otherwise, assume we are done.
       for (auto const &group : groups) {
         if (!group.second->archivist->finished_) {
+          for (auto const &org : group.second->population) {
+            org->collectUpdateCacheStats();
+          }
           group.second->optimize(); // create the next updates population
           group.second->archive(); // save data, update memory and delete unneeded data;
           if (!group.second->archivist->finished_) {
@@ -179,13 +208,30 @@ int main(int argc, const char *argv[]) {
         }
       }
 	  std::cout << std::endl;
+      // everything written this update goes to disk (files are buffered)
+      if (Global::pipelineArchivePL->get()) {
+        getArchiveQueue().push([] { FileManager::flushAll(false); });
+      } else {
+        FileManager::flushAll(false);
+      }
       Global::update++; // advance time to create new population(s)
+
+      // checkpoint the start of the next update (and on ctrl-c, so the run
+      // can be continued)
+      auto checkpointInterval = Global::checkpointIntervalPL->get();
+      if (checkpointInterval > 0 && !done &&
+          (Global::update % checkpointInterval == 0 || userExitFlag)) {
+        getArchiveQueue().wait(); // files must be complete on disk
+        saveRunCheckpoint(groups);
+      }
     }
 
     // the run is finished... flush any data that has not been output yet
     for (auto const &group : groups) {
       group.second->archive(1);
     }
+    // and wait for the archive thread to finish writing (if pipelining)
+    getArchiveQueue().wait();
   } else if (Global::modePL->get() == "visualize") {
     ////////////////////////////////////////////////////////////////////////////////////
     // visualize mode
@@ -209,6 +255,7 @@ int main(int argc, const char *argv[]) {
               << std::endl;
     exit(1);
   }
+  FileManager::flushAll();
   return 0;
 }
 
@@ -377,8 +424,8 @@ constructAllGroupsFrom(const std::shared_ptr<AbstractWorld> &world,
           newGenomes[genome.first] = genome.second->makeLike();
         } else { // if this file is loaded ...
           auto name = "GENOME_" + genome.first;
-          genome.second->deserialize(genome.second->PT, orgData.second, name);
-          newGenomes[genome.first] = genome.second;
+          newGenomes[genome.first] = genome.second->makeLike();
+          newGenomes[genome.first]->deserialize(genome.second->PT, orgData.second, name);
         }
       }
       for (auto const &brain : templateBrains) {
@@ -492,3 +539,124 @@ constructAllGroupsFrom(const std::shared_ptr<AbstractWorld> &world,
   }
   return groups;
 }
+
+// A checkpoint holds everything that carries over from one update to the
+// next: the update, the random generator, the organism ID counter, the state
+// of the output files and, for each group, the archivist and the population
+// (genomes, brain data and organism data). Optimizers and worlds keep nothing
+// between updates. A restarted run writes the same files as a run that was
+// never stopped, if it is given the same settings.
+const std::string checkpointHeader = "MABE checkpoint 1";
+
+void saveRunCheckpoint(
+    const std::map<std::string, std::shared_ptr<Group>> &groups) {
+  auto fileName = FileManager::outputPrefix + "checkpoint.mabe";
+  // written next to the old checkpoint and then moved over it, so a run that
+  // is killed while saving still has the last checkpoint
+  CheckpointWriter out(fileName + ".tmp");
+  out.section(checkpointHeader);
+  out.put(Global::update);
+  out.put(Random::getRunSeed());
+  std::ostringstream generatorState;
+  generatorState << Random::getCommonGenerator();
+  out.put(generatorState.str());
+  FileManager::saveCheckpoint(out);
+  out.put(static_cast<uint64_t>(groups.size()));
+  for (auto const &group : groups) {
+    out.section(group.first);
+    group.second->archivist->saveCheckpoint(out);
+    out.put(static_cast<uint64_t>(group.second->population.size()));
+    for (auto const &org : group.second->population) {
+      out.put(static_cast<uint64_t>(org->genomes.size()));
+      for (auto const &genome : org->genomes) {
+        out.put(genome.first);
+        genome.second->saveCheckpoint(out);
+      }
+      out.put(static_cast<uint64_t>(org->brains.size()));
+      for (auto const &brain : org->brains) {
+        out.put(brain.first);
+        auto name = "BRAIN_" + brain.first;
+        brain.second->saveCheckpoint(out, name);
+      }
+      org->saveCheckpoint(out);
+    }
+  }
+  Organism::saveIDCounter(out); // last, loading organisms uses up IDs
+  out.close();
+  if (!out.good() ||
+      (std::rename((fileName + ".tmp").c_str(), fileName.c_str()) != 0 &&
+       (std::remove(fileName.c_str()) != 0 ||
+        std::rename((fileName + ".tmp").c_str(), fileName.c_str()) != 0))) {
+    std::cout << "error: could not write checkpoint \"" << fileName << "\""
+              << std::endl;
+    exit(1);
+  }
+  std::cout << "  saved checkpoint \"" << fileName << "\" at update "
+            << Global::update << std::endl;
+}
+
+void loadRunCheckpoint(const std::string &fileName,
+                       std::map<std::string, std::shared_ptr<Group>> &groups) {
+  CheckpointReader in(fileName);
+  if (!in.good()) {
+    std::cout << "error: could not open checkpoint \"" << fileName << "\""
+              << std::endl;
+    exit(1);
+  }
+  in.section(checkpointHeader);
+  in.get(Global::update);
+  Random::setRunSeed(in.get<uint64_t>());
+  auto generatorState = in.get<std::string>(); // set last, making brains
+                                               // may use random numbers
+  FileManager::loadCheckpoint(in);
+  if (in.get<uint64_t>() != groups.size()) {
+    std::cout << "error: checkpoint \"" << fileName
+              << "\" was written with different groups" << std::endl;
+    exit(1);
+  }
+  for (auto const &group : groups) {
+    in.section(group.first);
+    group.second->archivist->loadCheckpoint(in);
+    auto templateOrg = group.second->templateOrg;
+    group.second->population.clear();
+    auto populationSize = in.get<uint64_t>();
+    for (uint64_t i = 0; i < populationSize; i++) {
+      std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> genomes;
+      auto genomeCount = in.get<uint64_t>();
+      for (uint64_t g = 0; g < genomeCount; g++) {
+        auto name = in.get<std::string>();
+        if (templateOrg->genomes.find(name) == templateOrg->genomes.end()) {
+          std::cout << "error: checkpoint \"" << fileName
+                    << "\" has genome \"" << name
+                    << "\" which this run does not have" << std::endl;
+          exit(1);
+        }
+        genomes[name] = templateOrg->genomes[name]->makeLike();
+        genomes[name]->loadCheckpoint(in);
+      }
+
+      std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> brains;
+      auto brainCount = in.get<uint64_t>();
+      for (uint64_t b = 0; b < brainCount; b++) {
+        auto name = in.get<std::string>();
+        if (templateOrg->brains.find(name) == templateOrg->brains.end()) {
+          std::cout << "error: checkpoint \"" << fileName
+                    << "\" has brain \"" << name
+                    << "\" which this run does not have" << std::endl;
+          exit(1);
+        }
+        brains[name] = templateOrg->brains[name]->makeBrain(genomes);
+        auto prefix = "BRAIN_" + name;
+        brains[name]->loadCheckpoint(in, prefix);
+      }
+
+      auto org = std::make_shared<Organism>(genomes, brains, templateOrg->PT);
+      org->loadCheckpoint(in); // ID, ancestors, data map...
+      group.second->population.push_back(org);
+    }
+  }
+  Organism::loadIDCounter(in);
+  std::istringstream(generatorState) >> Random::getCommonGenerator();
+  std::cout << "Restarting from checkpoint \"" << fileName
+            << "\" at update " << Global::update << std::endl;
+}
@@ -0,0 +1,175 @@
+# mbin.py reads the columnar binary data files MABE writes when
+# ARCHIVIST_DEFAULT-format is binary (pop.mbin, max.mbin, snapshot_data_*.mbin,
+# LOD_data.mbin, ...). The file layout is described in
+# code/Utilities/ColumnarTable.h.
+#
+# as a script:
+#   python mbin.py tocsv pop.mbin [more.mbin ...]
+#       writes pop.csv (etc.), the same text MABE would have written
+#   python mbin.py show pop.mbin
+#       prints the columns and their types
+#
+# as a module:
+#   import mbin
+#   columns = mbin.read('pop.mbin')   # OrderedDict, column name -> list
+#   df = mbin.read_dataframe('pop.mbin')  # needs pandas (mgraph.py uses this)
+
+import argparse
+import collections
+import os
+import struct
+import sys
+
+MAGIC = b'MABECOL\0'
+VERSION = 1
+
+TYPE_NAMES = {'b': 'bool', 'i': 'int', 'd': 'double', 's': 'string',
+              'B': 'bool list', 'I': 'int list', 'D': 'double list', 'S': 'string list'}
+
+
+def _varints(data, pos, count):
+    values = []
+    for _ in range(count):
+        value = 0
+        shift = 0
+        while True:
+            byte = data[pos]
+            pos += 1
+            value |= (byte & 0x7f) << shift
+            shift += 7
+            if byte < 0x80:
+                break
+        values.append(value)
+    return values, pos
+
+
+def _ints(data, encoding, count):
+    if encoding == 0:
+        return list(struct.unpack('<%dq' % count, data[:count * 8]))
+    zigzags, _ = _varints(data, 0, count)
+    values = []
+    previous = 0
+    for z in zigzags:
+        previous = (previous + ((z >> 1) ^ -(z & 1)) + 2**63) % 2**64 - 2**63
+        values.append(previous)
+    return values
+
+
+def _values(kind, data, encoding, count):
+    if kind == 'b':
+        return [int(b) for b in data[:count]]
+    if kind == 'i':
+        return _ints(data, encoding, count)
+    if kind == 'd':
+        return list(struct.unpack('<%dd' % count, data[:count * 8]))
+    lengths, pos = _varints(data, 0, count)
+    values = []
+    for length in lengths:
+        values.append(data[pos:pos + length].decode('utf-8', 'replace'))
+        pos += length
+    return values
+
+
+def _block(column_type, payload, encoding, rows):
+    if column_type.islower():
+        return _values(column_type, payload, encoding, rows)
+    lengths, pos = _varints(payload, 0, rows)
+    elements = _values(column_type.lower(), payload[pos:], encoding, sum(lengths))
+    lists = []
+    start = 0
+    for length in lengths:
+        lists.append(elements[start:start + length])
+        start += length
+    return lists
+
+
+def read_with_types(file_name):
+    """returns (OrderedDict of column name -> list of values, dict of column name -> type)"""
+    with open(file_name, 'rb') as f:
+        data = f.read()
+    if data[:8] != MAGIC:
+        sys.exit('mbin: ' + file_name + ' is not a MABE binary data file')
+    if data[8] != VERSION:
+        sys.exit('mbin: ' + file_name + ' has version ' + str(data[8]) +
+                 ', only version ' + str(VERSION) + ' can be read')
+    pos = 9
+    (count,) = struct.unpack_from('<I', data, pos)
+    pos += 4
+    names = []
+    types = {}
+    for _ in range(count):
+        (length,) = struct.unpack_from('<I', data, pos)
+        pos += 4
+        name = data[pos:pos + length].decode('utf-8')
+        pos += length
+        names.append(name)
+        types[name] = chr(data[pos])
+        pos += 1
+    columns = collections.OrderedDict((name, []) for name in names)
+    while pos + 4 <= len(data):
+        (rows,) = struct.unpack_from('<I', data, pos)
+        pos += 4
+        for name in names:
+            encoding = data[pos]
+            (size,) = struct.unpack_from('<I', data, pos + 1)
+            pos += 5
+            columns[name].extend(_block(types[name], data[pos:pos + size], encoding, rows))
+            pos += size
+    return columns, types
+
+
+def read(file_name):
+    return read_with_types(file_name)[0]
+
+
+def read_dataframe(file_name):
+    import pandas
+    return pandas.DataFrame(read(file_name))
+
+
+def _text(kind, value):
+    if kind in 'bi':
+        return str(value)
+    if kind == 'd':
+        return '%f' % value
+    return value
+
+
+def to_csv(file_name, csv_name):
+    """write the csv file MABE would have written"""
+    columns, types = read_with_types(file_name)
+    names = list(columns)
+    with open(csv_name, 'w', newline='') as out:
+        out.write(','.join(names) + '\n')
+        rows = len(columns[names[0]]) if names else 0
+        for row in range(rows):
+            cells = []
+            for name in names:
+                kind = types[name]
+                value = columns[name][row]
+                if kind == 's':
+                    cells.append('"' + value + '"')
+                elif kind.isupper():
+                    text = ''.join(_text(kind.lower(), v) + ',' for v in value)
+                    if len(text) > 2:  # as DataMap::getStringOfVector
+                        text = text[:-1]
+                    cells.append('"' + text + '"')
+                else:
+                    cells.append(_text(kind, value))
+            out.write(','.join(cells) + '\n')
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='read MABE binary (.mbin) data files')
+    parser.add_argument('command', choices=['tocsv', 'show'])
+    parser.add_argument('files', nargs='+', metavar='FILE')
+    args = parser.parse_args()
+    for file_name in args.files:
+        if args.command == 'tocsv':
+            to_csv(file_name, os.path.splitext(file_name)[0] + '.csv')
+        else:
+            columns, types = read_with_types(file_name)
+            rows = len(next(iter(columns.values()))) if columns else 0
+            print(file_name + ': ' + str(rows) + ' rows')
+            for name in columns:
+                print('  ' + name + ' (' + TYPE_NAMES.get(types[name], types[name]) + ')')
@@ -77,6 +77,7 @@ if args.save != "":
 
 # imports
 from pandas import read_csv, concat
+import mbin # binary data files (ARCHIVIST_DEFAULT-format binary)
 import pandas
 import matplotlib.pyplot as plt
 import matplotlib.cm as cm
@@ -391,7 +392,10 @@ def load_data(args, condition_folder_names, condition_user_names, replicates, fi
             for r in replicates:
                 complete_path = args.path + c_f + r + f
                 if args.verbose: print ("loading file: " + complete_path,flush=True)
-                df_all = read_csv(complete_path)
+                if complete_path.endswith('.mbin'):
+                    df_all = mbin.read_dataframe(complete_path)
+                else:
+                    df_all = read_csv(complete_path)
                 last_x_value = df_all[args.xAxis].iat[-1]
                 if updateMin == 'undefined':
                     updateMin = last_x_value